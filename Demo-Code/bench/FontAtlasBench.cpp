@@ -0,0 +1,99 @@
+/**
+ * @brief Offline benchmark for the glyph atlas packer.
+ *
+ * Rasterizes the 128 ASCII glyphs of every font in assets/fonts at the pixel heights main.cpp picks for
+ * common window heights (height / 32, at least 16) and packs them with the skyline packer. Prints the
+ * atlas size, packing density, texture memory and rasterize/pack times, followed by the signed distance
+ * field atlases Font actually uses, one per render height (see fontSdfPixelHeight()). Finally rasterizes
+ * ASCII and Latin-1 at the largest render height with a GlyphRasterizer, on one worker and on the default
+ * worker count, face loading included.
+ * Run from the Demo-Code directory.
+ */
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "graphics/GlyphAtlas.h"
+#include "graphics/GlyphRasterizer.h"
+
+int main() {
+    const char* fonts[] = {"VT323-Regular.ttf", "DejaVuSansMono.ttf", "lucon.ttf"};
+    // 480p .. 8K window heights
+    const int windowHeights[] = {480, 720, 1080, 1440, 2160, 4320};
+
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft)) {
+        std::fprintf(stderr, "Failed to init FreeType library\n");
+        return 1;
+    }
+
+    std::printf("%-20s %7s %6s %11s %8s %9s %10s %8s\n", "font", "window", "px", "atlas", "density", "texture",
+                "raster ms", "pack ms");
+    for (const char* name : fonts) {
+        std::string path = std::string("assets/fonts/") + name;
+        FT_Face face;
+        if (FT_New_Face(ft, path.c_str(), 0, &face)) {
+            std::fprintf(stderr, "Failed to load font: %s\n", path.c_str());
+            continue;
+        }
+        // negative rows stand for the SDF atlas at each render height
+        std::vector<int> rows(std::begin(windowHeights), std::end(windowHeights));
+        for (int h = FONT_SDF_PIXEL_HEIGHT; h <= FONT_SDF_MAX_PIXEL_HEIGHT; h *= 2) rows.push_back(-h);
+        for (int windowHeight : rows) {
+            bool sdf = windowHeight < 0;
+            int pixelHeight = sdf ? -windowHeight : std::max(16, windowHeight / 32);
+            FT_Set_Pixel_Sizes(face, 0, pixelHeight);
+
+            auto t0 = std::chrono::steady_clock::now();
+            std::vector<GlyphBitmap> glyphs;
+            rasterizeGlyphs(face, 0, 127, glyphs);
+            if (sdf) {
+                for (auto& glyph : glyphs) makeDistanceField(glyph, fontSdfSpread(pixelHeight));
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            GlyphAtlasImage atlas;
+            bool packed = packGlyphAtlas(glyphs, atlas);
+            auto t2 = std::chrono::steady_clock::now();
+
+            char size[32];
+            std::snprintf(size, sizeof(size), "%dx%d", atlas.width, atlas.height);
+            char window[16];
+            std::snprintf(window, sizeof(window), sdf ? "sdf" : "%d", windowHeight);
+            std::printf("%-20s %7s %6d %11s %7.1f%% %6zu KB %10.2f %8.3f%s\n", name, window, pixelHeight, size,
+                        atlas.density() * 100.0f, atlas.pixels.size() / 1024,
+                        std::chrono::duration<double, std::milli>(t1 - t0).count(),
+                        std::chrono::duration<double, std::milli>(t2 - t1).count(), packed ? "" : "  FAILED");
+        }
+        FT_Done_Face(face);
+    }
+    FT_Done_FreeType(ft);
+
+    std::vector<uint32_t> codes;
+    for (uint32_t code = 32; code < 256; ++code) {
+        if (code < 127 || code > 160) codes.push_back(code);
+    }
+    std::vector<unsigned> threadCounts = {1};
+    if (GlyphRasterizer::defaultThreadCount() > 1) threadCounts.push_back(GlyphRasterizer::defaultThreadCount());
+
+    std::printf("\n%-20s %7s %6s %7s %10s\n", "font", "threads", "px", "glyphs", "raster ms");
+    for (const char* name : fonts) {
+        std::string path = std::string("assets/fonts/") + name;
+        for (unsigned threads : threadCounts) {
+            GlyphRasterizer rasterizer(threads);
+            rasterizer.open(path);
+
+            auto t0 = std::chrono::steady_clock::now();
+            rasterizer.submit(FONT_SDF_MAX_PIXEL_HEIGHT, codes);
+            std::vector<RasterizedGlyph> glyphs;
+            while (rasterizer.wait(glyphs) > 0) {
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            std::printf("%-20s %7u %6d %7zu %10.2f\n", name, threads, FONT_SDF_MAX_PIXEL_HEIGHT, glyphs.size(),
+                        std::chrono::duration<double, std::milli>(t1 - t0).count());
+        }
+    }
+    return 0;
+}
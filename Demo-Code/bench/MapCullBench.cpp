@@ -0,0 +1,118 @@
+/**
+ * @brief Offline benchmark for map LOD selection and viewport culling.
+ *
+ * Sweeps zoom and view center over the layered maps of LocateScene on a 1920x1080 screen and prints,
+ * averaged over the centers, how many chunks and vertices survive the RingIndex query at full resolution
+ * and at the selected LOD level, together with the query time. Chunks are cut the same way as in MapMesh.
+ * It also checks the int16 vertex format of MapMesh against the float points and reports the largest
+ * quantization error in pixels at the highest zoom. Run from the Demo-Code directory.
+ */
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "maps/MapCache.h"
+#include "maps/MapLod.h"
+#include "maps/MapQuantization.h"
+#include "maps/RingIndex.h"
+
+namespace {
+
+/**
+ * @brief Chunks of one level and their index.
+ */
+struct CulledLevel {
+    MapChunks chunks;
+    RingIndex index;
+
+    explicit CulledLevel(const PolylineSet& map) : chunks(splitRings(map, MAP_CHUNK_POINTS)) { index.build(chunks.bounds); }
+
+    /**
+     * @brief Query the view and return the number of visible vertices; counts the visible chunks.
+     */
+    size_t visibleVertices(const MapBounds& view, std::vector<uint32_t>& visible) const {
+        index.query(view, visible);
+        size_t vertices = 0;
+        for (uint32_t chunk : visible) vertices += chunks.counts[chunk];
+        return vertices;
+    }
+};
+
+}  // namespace
+
+int main() {
+    const float width = 1920.0f, height = 1080.0f;
+    const float maxPixelError = 0.5f;  // Config::mapLodPixelError default
+
+    const MapNorm norm_de = {5.0f, 16.0f, 47.0f, 55.0f};
+    const MapNorm norm_saar = {6.35f, 7.45f, 49.11f, 49.65f};
+    const MapNorm norm_htw = {6.970, 6.978, 49.234, 49.242};
+    const struct {
+        const char* name;
+        MapNorm norm;
+        float scale;  // mapScale of the locate step, relative to the screen height
+    } maps[] = {{"world", norm_de, 0.02f}, {"germany", norm_de, 0.08f}, {"saarland", norm_saar, 0.04f},
+                {"htwsaar", norm_htw, 0.02f}};
+    const float zooms[] = {0.5f, 1.0f, 2.0f, 5.0f, 10.0f, 20.0f};
+    const int centerSteps = 9;  // centers on a 9 x 9 grid over [-1, 1]^2 map units
+
+    std::printf("%-9s %6s %12s %12s %12s %12s %10s\n", "map", "zoom", "vis chunks", "vertices", "full vis", "lod vis",
+                "query us");
+    std::vector<std::string> quantizationReport;
+    for (const auto& m : maps) {
+        PolylineSet map = loadMap(std::string("assets/maps/") + m.name + ".geo.json", m.norm);
+        std::vector<MapLod> lods = buildMapLods(map);
+        std::vector<CulledLevel> levels;
+        levels.emplace_back(map);
+        for (const auto& lod : lods) levels.emplace_back(lod.map);
+
+        const float mapScale = height * m.scale;
+
+        // the float path uploads 8 bytes per vertex, the quantized path 4, for all levels together
+        MapQuantization quantization = computeQuantization(map);
+        float maxError = maxQuantizationError(map, quantization);
+        size_t totalVertices = map.pointCount();
+        for (const auto& lod : lods) totalVertices += lod.map.pointCount();
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-9s %10.3g %12.4f %9zu KB %9zu KB", m.name, maxError,
+                      maxError * mapScale * zooms[std::size(zooms) - 1], totalVertices * sizeof(glm::vec2) / 1024,
+                      totalVertices * sizeof(QuantizedPoint) / 1024);
+        quantizationReport.push_back(line);
+        std::vector<uint32_t> visible;
+        for (float zoom : zooms) {
+            // same rule as MapMesh::selectLevel: coarsest level within the pixel budget
+            size_t selected = 0;
+            for (size_t i = 0; i < lods.size(); ++i) {
+                if (lods[i].tolerance * mapScale * zoom > maxPixelError) break;
+                selected = i + 1;
+            }
+
+            // view size in map units: the screen covers width / zoom world units, one map unit is mapScale
+            glm::vec2 half(width / zoom / 2.0f / mapScale, height / zoom / 2.0f / mapScale);
+            double chunks = 0, fullVertices = 0, lodVertices = 0, queryUs = 0;
+            for (int iy = 0; iy < centerSteps; ++iy) {
+                for (int ix = 0; ix < centerSteps; ++ix) {
+                    glm::vec2 center(-1.0f + 2.0f * ix / (centerSteps - 1), -1.0f + 2.0f * iy / (centerSteps - 1));
+                    MapBounds view{center - half, center + half};
+
+                    auto t0 = std::chrono::steady_clock::now();
+                    lodVertices += levels[selected].visibleVertices(view, visible);
+                    auto t1 = std::chrono::steady_clock::now();
+                    queryUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+                    chunks += visible.size();
+
+                    fullVertices += levels[0].visibleVertices(view, visible);
+                }
+            }
+            const double n = centerSteps * centerSteps;
+            std::printf("%-9s %6.1f %5.0f/%-6zu %12zu %12.0f %12.0f %10.2f\n", m.name, zoom, chunks / n,
+                        levels[selected].chunks.counts.size(), map.pointCount(), fullVertices / n, lodVertices / n, queryUs / n);
+        }
+    }
+
+    std::printf("\n%-9s %10s %12s %12s %12s\n", "map", "max error", "px @ max zoom", "float VBO", "int16 VBO");
+    for (const auto& line : quantizationReport) std::printf("%s\n", line.c_str());
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @brief Offline benchmark for the GeoJSON map loader.
+ *
+ * Loads every file in assets/maps with the old DOM based loader, the streaming SAX loader and the
+ * memory-mapped binary cache and prints load time, heap allocation count and allocated bytes for each.
+ * Run from the Demo-Code directory.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+#include "maps/GeoJSONLoader.h"
+#include "maps/MapCache.h"
+
+static std::atomic<size_t> allocCount{0};
+static std::atomic<size_t> allocBytes{0};
+
+// Counting replacements of the plain, array and nothrow forms, so every new/delete pair goes through malloc/free.
+// The deletes stay out of line: inlined into callers, GCC would see free() on memory from operator new and warn.
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+static void* countedAlloc(std::size_t size) noexcept {
+    allocCount++;
+    allocBytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+/**
+ * @brief Reference implementation: the DOM based loader LocateScene used before the SAX loader.
+ */
+static std::vector<std::vector<glm::vec2>> loadMapFromGeoJSONDom(const std::string& filename, const MapNorm& norm) {
+    std::vector<std::vector<glm::vec2>> map;
+    std::ifstream infile(filename);
+    nlohmann::json j;
+    infile >> j;
+
+    auto addRing = [&](const nlohmann::json& ring) {
+        std::vector<glm::vec2> poly;
+        for (const auto& pt : ring) {
+            float x = (pt[0].get<float>() - norm.lon_min) / (norm.lon_max - norm.lon_min) * 2.0f - 1.0f;
+            float y = (pt[1].get<float>() - norm.lat_min) / (norm.lat_max - norm.lat_min) * 2.0f - 1.0f;
+            poly.emplace_back(x, y);
+        }
+        map.push_back(poly);
+    };
+
+    for (const auto& feature : j["features"]) {
+        const auto& geom = feature["geometry"];
+        std::string type = geom["type"];
+        if (type == "Polygon") {
+            for (const auto& ring : geom["coordinates"]) addRing(ring);
+        } else if (type == "MultiPolygon") {
+            for (const auto& polygon : geom["coordinates"])
+                for (const auto& ring : polygon) addRing(ring);
+        } else if (type == "LineString") {
+            addRing(geom["coordinates"]);
+        }
+    }
+    return map;
+}
+
+static void count(const std::vector<std::vector<glm::vec2>>& map, size_t& rings, size_t& points) {
+    rings = map.size();
+    points = 0;
+    for (const auto& ring : map) points += ring.size();
+}
+
+static void count(const PolylineSet& map, size_t& rings, size_t& points) {
+    rings = map.ringCount();
+    points = map.pointCount();
+}
+
+struct Result {
+    double ms;
+    size_t allocs, bytes, rings, points;
+};
+
+template <typename Loader>
+static Result measure(Loader loader, const std::string& file, const MapNorm& norm, int iterations) {
+    Result r{0.0, 0, 0, 0, 0};
+    for (int i = 0; i < iterations; ++i) {
+        size_t allocs0 = allocCount, bytes0 = allocBytes;
+        auto t0 = std::chrono::steady_clock::now();
+        auto map = loader(file, norm);
+        auto t1 = std::chrono::steady_clock::now();
+        r.ms += std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+        r.allocs = allocCount - allocs0;
+        r.bytes = allocBytes - bytes0;
+        count(map, r.rings, r.points);
+    }
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 5;
+    // same files and normalizations as LocateScene, so the baked caches are the ones the demo uses
+    const MapNorm norm_de = {5.0f, 16.0f, 47.0f, 55.0f};
+    const MapNorm norm_saar = {6.35f, 7.45f, 49.11f, 49.65f};
+    const MapNorm norm_htw = {6.970, 6.978, 49.234, 49.242};
+    const struct {
+        const char* name;
+        MapNorm norm;
+    } files[] = {{"world", norm_de},         {"germany", norm_de},        {"saarland", norm_saar},
+                 {"htwsaar", norm_htw},      {"simpleGermany", norm_de},  {"simpleSaarland", norm_de},
+                 {"saarbruecken", norm_saar}};
+
+    std::printf("%-16s %9s %9s %9s %11s %11s %11s %9s %9s %9s %8s\n", "file", "dom ms", "sax ms", "cache ms",
+                "dom allocs", "sax allocs", "cache allocs", "dom KiB", "sax KiB", "cache KiB", "points");
+    for (const auto& file : files) {
+        const char* name = file.name;
+        const MapNorm& norm = file.norm;
+        std::string path = std::string("assets/maps/") + name + ".geo.json";
+        Result dom = measure(loadMapFromGeoJSONDom, path, norm, iterations);
+        Result sax = measure(loadMapFromGeoJSON, path, norm, iterations);
+        loadMap(path, norm);  // bake the cache if it is missing or stale
+        Result cache = measure(loadMap, path, norm, iterations);
+        bool mismatch = dom.rings != sax.rings || dom.points != sax.points || sax.rings != cache.rings ||
+                        sax.points != cache.points;
+        std::printf("%-16s %9.2f %9.2f %9.3f %11zu %11zu %11zu %9zu %9zu %9zu %8zu%s\n", name, dom.ms, sax.ms,
+                    cache.ms, dom.allocs, sax.allocs, cache.allocs, dom.bytes / 1024, sax.bytes / 1024,
+                    cache.bytes / 1024, sax.points, mismatch ? "  MISMATCH" : "");
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @brief Offline micro-benchmark for the glyph lookup of Font.
+ *
+ * Lays out a 10k character string the way Font::renderText() does (one quad of six vertices per visible
+ * glyph) and measures it the way Font::getTextWidth() does, once with the std::map<char, Character> lookup
+ * and 26.6 fixed point advances Font used before and once with GlyphTable. Glyph metrics come from VT323
+ * rendered at FONT_SDF_PIXEL_HEIGHT. Prints the best time per character of each variant. Run from the Demo-Code
+ * directory.
+ */
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "graphics/GlyphAtlas.h"
+#include "graphics/GlyphTable.h"
+
+namespace {
+
+/**
+ * @brief Glyph record of the old lookup: advance in 1/64 pixels.
+ */
+struct OldCharacter {
+    glm::vec2 uvMin, uvMax;
+    glm::ivec2 size, bearing;
+    unsigned int advance;
+};
+
+/**
+ * @brief Reference implementation: the renderText loop as it was with std::map.
+ */
+void layoutOld(std::map<char, OldCharacter>& characters, const std::string& text, float x, float y, float scale,
+               std::vector<glm::vec4>& out) {
+    for (char c : text) {
+        if (c == '\t') {
+            OldCharacter space =
+                characters.count(' ') ? characters[' '] : OldCharacter{{0, 0}, {0, 0}, {0, 0}, {0, 0}, 10 << 6};
+            x += (space.advance >> 6) * scale * 4;
+            continue;
+        }
+        if (characters.find(c) == characters.end()) continue;
+        OldCharacter ch = characters[c];
+        if (isspace(c) && c != ' ') {
+            x += (ch.advance >> 6) * scale;
+            continue;
+        }
+        float xpos = x + ch.bearing.x * scale;
+        float ypos = y - (ch.size.y - ch.bearing.y) * scale;
+        float w = ch.size.x * scale;
+        float h = ch.size.y * scale;
+        if (w > 0 && h > 0) {
+            const glm::vec4 corners[6] = {
+                {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y}, {xpos, ypos, ch.uvMin.x, ch.uvMax.y},
+                {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y}, {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y},
+                {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y}, {xpos + w, ypos + h, ch.uvMax.x, ch.uvMin.y}};
+            out.insert(out.end(), std::begin(corners), std::end(corners));
+        }
+        x += (ch.advance >> 6) * scale;
+    }
+}
+
+/**
+ * @brief The renderText loop with GlyphTable.
+ */
+void layoutTable(const GlyphTable& glyphs, const std::string& text, float x, float y, float scale,
+                 std::vector<glm::vec4>& out) {
+    const Character* space = glyphs.find(' ');
+    const float tabAdvance = (space ? space->advance : 10.0f) * 4.0f;
+    for (char c : text) {
+        if (c == '\t') {
+            x += tabAdvance * scale;
+            continue;
+        }
+        const Character* glyph = glyphs.find(static_cast<unsigned char>(c));
+        if (!glyph) continue;
+        const Character& ch = *glyph;
+        if (isspace(static_cast<unsigned char>(c)) && c != ' ') {
+            x += ch.advance * scale;
+            continue;
+        }
+        float xpos = x + ch.bearing.x * scale;
+        float ypos = y - (ch.size.y - ch.bearing.y) * scale;
+        float w = ch.size.x * scale;
+        float h = ch.size.y * scale;
+        if (w > 0 && h > 0) {
+            const glm::vec4 corners[6] = {
+                {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y}, {xpos, ypos, ch.uvMin.x, ch.uvMax.y},
+                {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y}, {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y},
+                {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y}, {xpos + w, ypos + h, ch.uvMax.x, ch.uvMin.y}};
+            out.insert(out.end(), std::begin(corners), std::end(corners));
+        }
+        x += ch.advance * scale;
+    }
+}
+
+/**
+ * @brief Best wall time of several runs, in nanoseconds per character.
+ */
+template <typename F>
+double bestNsPerChar(F&& run, size_t chars) {
+    double best = 1e30;
+    for (int i = 0; i < 50; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        run();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    return best / double(chars);
+}
+
+}  // namespace
+
+int main() {
+    FT_Library ft;
+    FT_Face face;
+    if (FT_Init_FreeType(&ft) || FT_New_Face(ft, "assets/fonts/VT323-Regular.ttf", 0, &face)) {
+        std::fprintf(stderr, "Failed to load assets/fonts/VT323-Regular.ttf\n");
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(face, 0, FONT_SDF_PIXEL_HEIGHT);
+    std::vector<GlyphBitmap> bitmaps;
+    rasterizeGlyphs(face, 0, 127, bitmaps);
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    GlyphAtlasImage atlas;
+    packGlyphAtlas(bitmaps, atlas);
+
+    GlyphTable table;
+    for (const auto& glyph : bitmaps) table.insert(glyph);
+    std::map<char, OldCharacter> characters;
+    for (const auto& glyph : bitmaps) {
+        const Character& ch = *table.find(glyph.code);
+        characters[static_cast<char>(glyph.code)] = {ch.uvMin, ch.uvMax, ch.size, ch.bearing,
+                                                     static_cast<unsigned int>(glyph.advance)};
+    }
+
+    // terminal-like content: code lines with indentation and the odd tab
+    const std::string line = "\tfor (int i = 0; i < count; ++i) { total += values[i] * 0.5f; }  // 0x7F ~ ok\n";
+    std::string text;
+    while (text.size() < 10000) text += line;
+    text.resize(10000);
+
+    std::vector<glm::vec4> vertices;
+    vertices.reserve(text.size() * 6);
+    const float scale = 33.0f / FONT_SDF_PIXEL_HEIGHT;  // 1080p text from the 64 px atlas
+
+    double oldLayout = bestNsPerChar(
+        [&]() {
+            vertices.clear();
+            layoutOld(characters, text, 10.0f, 500.0f, scale, vertices);
+        },
+        text.size());
+    double tableLayout = bestNsPerChar(
+        [&]() {
+            vertices.clear();
+            layoutTable(table, text, 10.0f, 500.0f, scale, vertices);
+        },
+        text.size());
+
+    volatile float sink = 0.0f;
+    double oldWidth = bestNsPerChar(
+        [&]() {
+            float width = 0.0f;
+            for (char c : text) {
+                auto it = characters.find(c);
+                if (it != characters.end()) width += (it->second.advance >> 6) * scale;
+            }
+            sink = width;
+        },
+        text.size());
+    double tableWidth = bestNsPerChar(
+        [&]() {
+            float width = 0.0f;
+            for (char c : text) {
+                if (const Character* glyph = table.find(static_cast<unsigned char>(c))) width += glyph->advance * scale;
+            }
+            sink = width;
+        },
+        text.size());
+
+    std::printf("%zu characters, %zu glyphs\n", text.size(), table.size());
+    std::printf("%-14s %12s %12s %8s\n", "", "std::map ns", "table ns", "speedup");
+    std::printf("%-14s %12.2f %12.2f %7.1fx\n", "renderText", oldLayout, tableLayout, oldLayout / tableLayout);
+    std::printf("%-14s %12.2f %12.2f %7.1fx\n", "getTextWidth", oldWidth, tableWidth, oldWidth / tableWidth);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @brief Offline throughput benchmark for the terminal emulation core.
+ *
+ * Generates about 16 MB of typical terminal output (colored directory listings, plain log lines, cursor
+ * positioning and erasing as full screen programs do, scrolling inside a scroll region, UTF-8 text) and
+ * feeds it to a VtTerminal in 4 KB chunks, the way output arrives from a pipe. Prints the best parse
+ * throughput of a few runs for each kind of output and for the mix, and the average number of cells a
+ * renderer would upload per frame if about a line of output arrived each frame (the changed range of the
+ * grid, see CellGridRenderer), then replays
+ * assets/casts/demo.cast through CastPlayer as fast as possible. Run from the Demo-Code directory.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "terminal/CastPlayer.h"
+#include "terminal/VtTerminal.h"
+
+namespace {
+
+constexpr size_t TARGET_BYTES = 16 << 20;
+constexpr size_t CHUNK_BYTES = 4096;
+constexpr size_t FRAME_BYTES = 80;
+constexpr int RUNS = 5;
+
+/**
+ * @brief Colored `ls -l` style lines.
+ */
+std::string makeListing() {
+    static const char* colors[] = {"\x1b[0m", "\x1b[01;34m", "\x1b[01;32m", "\x1b[01;36m", "\x1b[38;5;208m"};
+    std::string out;
+    char line[160];
+    for (int i = 0; out.size() < TARGET_BYTES; ++i) {
+        std::snprintf(line, sizeof(line), "-rw-r--r-- 1 user user %8d Oct 16 12:%02d %sfile_%06d.txt\x1b[0m\r\n",
+                      i * 37 % 100000, i % 60, colors[i % 5], i);
+        out += line;
+    }
+    return out;
+}
+
+/**
+ * @brief Uncolored log lines, the ASCII fast path.
+ */
+std::string makePlain() {
+    std::string out;
+    char line[160];
+    for (int i = 0; out.size() < TARGET_BYTES; ++i) {
+        std::snprintf(line, sizeof(line), "[%08d] worker %d: processed request %d in %d us, status ok\r\n", i, i % 8,
+                      i * 7, i % 977);
+        out += line;
+    }
+    return out;
+}
+
+/**
+ * @brief Full screen redraws: cursor positioning, erase line, short colored fields, as in top or htop.
+ */
+std::string makeCursor() {
+    std::string out;
+    char field[96];
+    for (int i = 0; out.size() < TARGET_BYTES; ++i) {
+        if (i % 24 == 0) out += "\x1b[H\x1b[2J";
+        std::snprintf(field, sizeof(field), "\x1b[%d;1H\x1b[K\x1b[1;33m%5d\x1b[0m %-12s \x1b[32m%5.1f%%\x1b[39m",
+                      i % 24 + 1, 1000 + i % 5000, "process", (i % 1000) / 10.0);
+        out += field;
+        std::snprintf(field, sizeof(field), "\x1b[%d;60H\x1b[38;2;%d;%d;200m%8d KB\x1b[0m", i % 24 + 1, i % 256,
+                      (i * 3) % 256, i * 13 % 1000000);
+        out += field;
+    }
+    return out;
+}
+
+/**
+ * @brief Lines appended inside a scroll region (status line kept), with reverse index and insert/delete line.
+ */
+std::string makeScroll() {
+    std::string out = "\x1b[2;23r";
+    char line[128];
+    for (int i = 0; out.size() < TARGET_BYTES; ++i) {
+        std::snprintf(line, sizeof(line), "\x1b[23;1Hline %d of the scrolling region, UTF-8: \xc3\xa4\xc3\xb6\xc3\xbc \xe2\x86\x92\n", i);
+        out += line;
+        if (i % 16 == 0) out += "\x1b[2;1H\x1bM\x1b[3L\x1b[2M\x1b[24;1H\x1b[7mstatus\x1b[0m";
+    }
+    return out + "\x1b[r";
+}
+
+/**
+ * @brief Feeds output in CHUNK_BYTES pieces and returns the best throughput in MB/s.
+ */
+double measure(const std::string& output) {
+    VtTerminal terminal(80, 24);
+    double best = 1e30;
+    for (int run = 0; run < RUNS; ++run) {
+        terminal.reset();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < output.size(); offset += CHUNK_BYTES) {
+            terminal.write(output.data() + offset, std::min(CHUNK_BYTES, output.size() - offset));
+        }
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return output.size() / best / (1 << 20);
+}
+
+/**
+ * @brief Feeds output in FRAME_BYTES pieces and returns the average changed range per piece, in cells.
+ */
+double changedPerFrame(const std::string& output) {
+    VtTerminal terminal(80, 24);
+    size_t changed = 0, frames = 0;
+    for (size_t offset = 0; offset < output.size(); offset += FRAME_BYTES, ++frames) {
+        terminal.write(output.data() + offset, std::min(FRAME_BYTES, output.size() - offset));
+        CellGrid& grid = terminal.getGrid();
+        changed += grid.getChangedEnd() - grid.getChangedBegin();
+        grid.markUnchanged();
+    }
+    return frames ? double(changed) / frames : 0.0;
+}
+
+}  // namespace
+
+int main() {
+    const std::string listing = makeListing();
+    const std::string plain = makePlain();
+    const std::string cursor = makeCursor();
+    const std::string scroll = makeScroll();
+    std::string mixed;
+    for (size_t offset = 0; offset < TARGET_BYTES; offset += 1 << 16) {
+        mixed.append(listing, offset, 1 << 16);
+        mixed.append(plain, offset, 1 << 16);
+        mixed.append(cursor, offset, 1 << 16);
+        mixed.append(scroll, offset, 1 << 16);
+    }
+
+    std::printf("%-10s %10s %10s %12s\n", "output", "MB", "MB/s", "cells/frame");
+    const std::pair<const char*, const std::string*> cases[] = {
+        {"listing", &listing}, {"plain", &plain}, {"cursor", &cursor}, {"scroll", &scroll}, {"mixed", &mixed}};
+    for (const auto& c : cases) {
+        std::printf("%-10s %10.1f %10.1f %12.0f\n", c.first, c.second->size() / double(1 << 20), measure(*c.second),
+                    changedPerFrame(*c.second));
+    }
+
+    CastPlayer player;
+    if (!player.open("assets/casts/demo.cast")) return 1;
+    VtTerminal terminal(player.getWidth(), player.getHeight());
+    auto start = std::chrono::steady_clock::now();
+    size_t events = player.advance(1e30, terminal);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("demo.cast: %zu events, %.1f s session replayed in %.2f ms\n", events, player.getLastEventTime(),
+                seconds * 1000.0);
+    return 0;
+}
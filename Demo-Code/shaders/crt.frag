@@ -4,6 +4,11 @@ in vec2 TexCoords;
 uniform sampler2D screenTexture;
 uniform float time;
 
+#ifdef TV_COLLAPSE
+// Transition variant: the TV collapse is applied in the same pass, on the screen position of the pixel
+uniform float closeAnim;
+#endif
+
 // Simple noise function
 float rand(vec2 co){
     return fract(sin(dot(co.xy ,vec2(12.9898,78.233))) * 43758.5453);
@@ -17,16 +22,16 @@ vec2 barrelDistort(vec2 uv, float amt) {
     return (uv + 1.0) * 0.5;
 }
 
-void main()
+vec3 crt()
 {
     // Barrel distortion (screen curve)
     vec2 uv = barrelDistort(TexCoords, 0.18);
 
-    // RGB color offset (chromatic aberration)
+    // RGB color offset (chromatic aberration); explicit LOD (no mipmaps) so crt() may run in a branch
     float offset = 0.0007; 
-    float r = texture(screenTexture, uv + vec2(offset, 0.0)).r;
-    float g = texture(screenTexture, uv).g;
-    float b = texture(screenTexture, uv - vec2(offset, 0.0)).b;
+    float r = textureLod(screenTexture, uv + vec2(offset, 0.0), 0.0).r;
+    float g = textureLod(screenTexture, uv, 0.0).g;
+    float b = textureLod(screenTexture, uv - vec2(offset, 0.0), 0.0).b;
     vec3 color = vec3(r, g, b);
 
     // Rolling scanline effect
@@ -41,7 +46,43 @@ void main()
     float noise = (rand(uv * time) - 0.5) * 0.12;
     color += noise;
 
-    color = clamp(color, 0.0, 1.0);
+    return clamp(color, 0.0, 1.0);
+}
+
+#ifdef TV_COLLAPSE
+vec3 collapse()
+{
+    float anim = clamp(closeAnim * 2.0, 0.0, 1.0);   // The tube collapses in the first half of closeAnim
+    float edgeDist = abs(TexCoords.y - 0.5);
+
+    if (anim >= 1.0) {
+        return vec3(0.0);                             // Fully collapsed - black
+    }
+    if (anim >= 0.8) {
+        // Final collapse to a white line, then a quick fade to black; the picture is gone
+        float scanLine = 1.0 - smoothstep(0.001, 0.002, edgeDist);
+        return vec3(scanLine) * (1.0 - smoothstep(0.9, 1.0, anim));
+    }
 
-    FragColor = vec4(color, 1.0);
+    // Picture within the band that is left of the screen, collapsing to a line
+    float visibleHeight = (1.0 - anim) * 0.5;
+    float mask = smoothstep(visibleHeight + 0.01, visibleHeight, edgeDist);
+    vec3 color = mask > 0.0 ? crt() * mask : vec3(0.0);  // No CRT work for pixels outside the band
+
+    // White line in the center when almost collapsed
+    if (anim > 0.6) {
+        float scanLine = 1.0 - smoothstep(0.003, 0.006, edgeDist);
+        color = mix(color, vec3(1.0), scanLine * 0.9);
+    }
+    return color;
+}
+#endif
+
+void main()
+{
+#ifdef TV_COLLAPSE
+    FragColor = vec4(collapse(), 1.0);
+#else
+    FragColor = vec4(crt(), 1.0);
+#endif
 }
\ No newline at end of file
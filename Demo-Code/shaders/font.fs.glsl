@@ -1,11 +1,15 @@
 #version 330 core
 in vec2 TexCoords;
+in vec3 TextColor;
 out vec4 FragColor;
 
-uniform sampler2D text;
-uniform vec3 textColor;
+uniform sampler2D text; // signed distance field, 0.5 on the glyph outline
 
 void main() {
-    float alpha = texture(text, TexCoords).r;
-    FragColor = vec4(textColor, alpha);
+    // texture coordinates arrive in atlas pixels, so they survive the atlas growing
+    float dist = texture(text, TexCoords / vec2(textureSize(text, 0))).r;
+    // antialias over about one screen pixel, whatever the scale
+    float width = fwidth(dist);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+    FragColor = vec4(TextColor, alpha);
 }
@@ -1,11 +1,22 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec4 color;
+layout (location = 2) in float index; // byte offset of the character, -(offset + 1) for cursor quads
 
 out vec2 TexCoords;
+out vec3 TextColor;
 
 uniform mat4 projection;
+uniform vec2 offset; // position of a text run, zero for the frame's batch
+uniform float visibleBytes; // characters starting before this offset are shown
+uniform bool cursor; // show the cursor quad at visibleBytes
 
 void main() {
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+    bool isCursor = index < 0.0;
+    float at = isCursor ? -index - 1.0 : index;
+    bool visible = isCursor ? cursor && at == visibleBytes : at < visibleBytes;
+    // hidden quads collapse outside the clip volume and are dropped before rasterization
+    gl_Position = visible ? projection * vec4(vertex.xy + offset, 0.0, 1.0) : vec4(2.0, 2.0, 2.0, 1.0);
     TexCoords = vertex.zw;
+    TextColor = color.rgb;
 }
@@ -0,0 +1,8 @@
+#version 330 core
+layout(location = 0) in vec2 aPos; // already in clip space
+layout(location = 1) in vec4 aColor;
+out vec4 vColor;
+void main() {
+    vColor = aColor;
+    gl_Position = vec4(aPos, 0.0, 1.0);
+}
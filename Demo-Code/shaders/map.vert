@@ -0,0 +1,14 @@
+#version 330 core
+layout(location = 0) in vec2 aPos;      // int16 grid coordinates
+layout(location = 1) in vec2 aCentroid; // ring centroid on the same grid; meshes without it read (0, 0)
+uniform mat4 projection;
+uniform vec2 uQuantCenter; // map units of grid position (0, 0)
+uniform vec2 uQuantStep;   // map units per grid step
+uniform vec2 uOffset;
+uniform float uScale;
+uniform float uPulse; // scale of each ring about its centroid, 1.0 for plain maps
+void main() {
+    vec2 grid = aCentroid + (aPos - aCentroid) * uPulse;
+    vec2 pos = uQuantCenter + grid * uQuantStep;
+    gl_Position = projection * vec4(uOffset + pos * uScale, 0.0, 1.0);
+}
@@ -0,0 +1,31 @@
+#version 330 core
+// one instance per terminal cell, see CellGridRenderer
+layout (location = 0) in vec2 atlasPos;  // top left of the glyph in the atlas, atlas pixels
+layout (location = 1) in vec2 glyphSize; // zero for blank cells
+layout (location = 2) in vec2 bearing;
+layout (location = 3) in vec4 color;
+
+out vec2 TexCoords;
+out vec3 TextColor;
+
+uniform mat4 projection;
+uniform vec2 origin;   // pen position (baseline) of the top left cell
+uniform vec2 cellSize; // cell width and row height in screen pixels
+uniform int columns;
+uniform float firstRow; // row of the first instance below the top of the view, fractional while scrolling
+uniform float scale;   // atlas pixels to screen pixels
+
+const vec2 corners[6] = vec2[](vec2(0.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 0.0),
+                               vec2(0.0, 1.0), vec2(1.0, 0.0), vec2(1.0, 1.0));
+
+void main() {
+    int column = gl_InstanceID % columns;
+    float row = firstRow + float(gl_InstanceID / columns);
+    vec2 pen = origin + vec2(float(column) * cellSize.x, -row * cellSize.y);
+
+    vec2 corner = corners[gl_VertexID];
+    vec2 pos = pen + (vec2(bearing.x, bearing.y - glyphSize.y) + corner * glyphSize) * scale;
+    gl_Position = projection * vec4(pos, 0.0, 1.0);
+    TexCoords = atlasPos + vec2(corner.x, 1.0 - corner.y) * glyphSize;
+    TextColor = color.rgb;
+}
@@ -6,6 +6,8 @@
 int Config::width = 1920;  // Default values
 int Config::height = 1080;
 bool Config::fullscreen = false;
+float Config::mapLodPixelError = 0.5f;
+std::string Config::terminalSession;  // empty: built-in code demo
 
 
 /**
@@ -15,8 +17,8 @@ bool Config::fullscreen = false;
  * It updates the corresponding fields in the Config class based on the section and name.
  *
  * @param user Pointer to user data (unused).
- * @param section The section name in the INI file (e.g., "Window").
- * @param name The key name within the section (e.g., "Width", "Height", "Fullscreen").
+ * @param section The section name in the INI file (e.g., "Window", "Map", "Terminal").
+ * @param name The key name within the section (e.g., "Width", "Height", "Fullscreen", "LodPixelError", "Session").
  * @param value The value associated with the key as a string.
  * @return Always returns 1 to indicate success.
  */
@@ -29,6 +31,14 @@ static int handler(void* user, const char* section, const char* name, const char
         } else if (strcmp(name, "Fullscreen") == 0) {
             Config::fullscreen = atoi(value) != 0;
         }
+    } else if (strcmp(section, "Map") == 0) {
+        if (strcmp(name, "LodPixelError") == 0) {
+            Config::mapLodPixelError = static_cast<float>(atof(value));
+        }
+    } else if (strcmp(section, "Terminal") == 0) {
+        if (strcmp(name, "Session") == 0) {
+            Config::terminalSession = value;
+        }
     }
     return 1;
 }
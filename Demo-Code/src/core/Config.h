@@ -23,6 +23,8 @@ public:
     static int width;
     static int height;
     static bool fullscreen;
+    static float mapLodPixelError;
+    static std::string terminalSession;
 };
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 64 bit FNV-1a hash, used to key the baked caches on their source files.
+ * @param data Bytes to hash.
+ * @param size Number of bytes.
+ * @param hash Hash to continue from, for hashing several pieces in sequence.
+ * @return The updated hash.
+ */
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#endif  // HASH_H
@@ -0,0 +1,80 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Replacement character returned for malformed UTF-8.
+ */
+constexpr uint32_t UTF8_REPLACEMENT = 0xFFFD;
+
+/**
+ * @brief Decodes the code point starting at pos and moves pos past it.
+ *
+ * Malformed input (stray continuation bytes, truncated or overlong sequences, surrogates) yields
+ * UTF8_REPLACEMENT and skips a single byte, so decoding always makes progress.
+ *
+ * @param text UTF-8 encoded text.
+ * @param pos Byte offset of the sequence, less than text.size(); advanced to the next sequence.
+ * @return The code point.
+ */
+inline uint32_t decodeUtf8(const std::string& text, size_t& pos) {
+    const unsigned char lead = static_cast<unsigned char>(text[pos]);
+    if (lead < 0x80) {
+        ++pos;
+        return lead;
+    }
+
+    int length;
+    uint32_t code;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        code = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        code = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        code = lead & 0x07;
+    } else {
+        ++pos;
+        return UTF8_REPLACEMENT;
+    }
+    if (pos + length > text.size()) {
+        ++pos;
+        return UTF8_REPLACEMENT;
+    }
+    for (int i = 1; i < length; ++i) {
+        const unsigned char next = static_cast<unsigned char>(text[pos + i]);
+        if ((next & 0xC0) != 0x80) {
+            ++pos;
+            return UTF8_REPLACEMENT;
+        }
+        code = (code << 6) | (next & 0x3F);
+    }
+
+    static const uint32_t minimum[5] = {0, 0, 0x80, 0x800, 0x10000};
+    if (code < minimum[length] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+        ++pos;
+        return UTF8_REPLACEMENT;
+    }
+    pos += length;
+    return code;
+}
+
+/**
+ * @brief Byte offset of the code point after the one starting at pos, for typing text out one
+ * character at a time without cutting a sequence in half.
+ * @param text UTF-8 encoded text.
+ * @param pos Byte offset, at most text.size().
+ * @return Offset of the next sequence, at most text.size().
+ */
+inline size_t nextUtf8(const std::string& text, size_t pos) {
+    if (pos >= text.size()) return text.size();
+    ++pos;
+    while (pos < text.size() && (static_cast<unsigned char>(text[pos]) & 0xC0) == 0x80) ++pos;
+    return pos;
+}
+
+#endif  // UTF8_H
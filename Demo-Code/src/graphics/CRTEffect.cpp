@@ -4,56 +4,37 @@
 /**
  * @brief Constructor for CRTEffect class.
  * Initializes member variables to zero.
- * This sets up the OpenGL Framebuffer Object (FBO), screen texture, and shader program.
+ * This sets up the OpenGL vertex array, vertex buffer and shader program handles.
  */
-CRTEffect::CRTEffect() : fbo(0), screenTexture(0), quadVAO(0), quadVBO(0), shaderProgram(0) {}
+CRTEffect::CRTEffect() : quadVAO(0), quadVBO(0), shaderProgram(0), collapseProgram(0) {}
 
 /**
  * @brief Destructor for CRTEffect class.
- * Cleans up OpenGL resources by deleting the framebuffer, texture, vertex array object, vertex buffer object and shader program.
+ * Cleans up OpenGL resources by deleting the vertex array object, vertex buffer object and shader programs.
  */
 CRTEffect::~CRTEffect() {
     if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
     if (quadVBO) glDeleteBuffers(1, &quadVBO);
-    if (screenTexture) glDeleteTextures(1, &screenTexture);
-    if (fbo) glDeleteFramebuffers(1, &fbo);
     if (shaderProgram) glDeleteProgram(shaderProgram);
+    if (collapseProgram) glDeleteProgram(collapseProgram);
 }
 
 /**
- * @brief Initializes the CRTEffect with the specified width and height.
- * Sets up the framebuffer, texture, shader program, and quad for rendering.
- * @param width The width of the texture.
- * @param height The height of the texture.
+ * @brief Initializes the CRTEffect.
+ * Sets up the shader programs (plain and with the TV collapse) and quad for rendering. The screen texture comes from the render graph.
  */
-bool CRTEffect::initialize(int width, int height) {
-    // Setup FBO (Framebuffer Object)
-    glGenFramebuffers(1, &fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-
-    // Create texture for the FBO
-    glGenTextures(1, &screenTexture);                                                                   // Generate a texture to hold the rendered image
-    glBindTexture(GL_TEXTURE_2D, screenTexture);                                                        // Bind the texture to the GL_TEXTURE_2D target                   
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);           // Allocate storage for the texture with specified width and height
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);                                   // Set the texture minification filter to linear            
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);                                   // Set the texture magnification filter to linear      
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);                                // Set the texture wrapping mode for the S coordinate to clamp to edge
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);                                // Set the texture wrapping mode for the T coordinate to clamp to edge
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, screenTexture, 0);      // Attach the texture to the framebuffer as a color attachment
-
-    // Check if the framebuffer is completely set up
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        std::cerr << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;                  // If it isn't complete, print an error message
-        return false;                                                                                   // Return false to indicate failure, exit the function
-    }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);                                                               // Unbind the framebuffer to avoid accidental modifications                         
-
+bool CRTEffect::initialize() {
     // Setup shader
     shaderProgram = ShaderManager::loadShader("shaders/crt.vs", "shaders/crt.frag");                    // Load the vertex and fragment shaders using the ShaderManager class
     if (!shaderProgram){
         std::cerr << "ERROR::SHADER:: Failed to load shaders!" << std::endl;                            // If shader loading fails, print an error message
         return false;                                                                                   // Return false to indicate failure, exit the function
     } 
+    collapseProgram = ShaderManager::loadShader("shaders/crt.vs", "shaders/crt.frag", "#define TV_COLLAPSE\n");  // Same shader, specialized for the TV collapse transitions
+    if (!collapseProgram) {
+        std::cerr << "ERROR::SHADER:: Failed to load TV collapse shaders!" << std::endl;
+        return false;
+    }
 
     // Setup quad
     setupQuad();
@@ -61,48 +42,24 @@ bool CRTEffect::initialize(int width, int height) {
     return true;                                                                                        // Return true to indicate successful initialization
 }
 
-/**
- * @brief Resizes the screen texture to the specified width and height.
- * @param width The new width of the texture.
- * @param height The new height of the texture.
- * This function updates the texture size to match the window dimensions.
- */
-void CRTEffect::resize(int width, int height) {
-    glBindTexture(GL_TEXTURE_2D, screenTexture);                                                        // Bind the texture to modify its properties -> was unbound in initialize()                 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);           // Update the texture with new dimensions
-}
-
-/**
- * @brief Begins rendering to the framebuffer.
- * Clears the framebuffer with a specific color.
- */
-void CRTEffect::beginRender() {
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);                                                             // Bind the framebuffer to render to it                
-    glClearColor(0.04f, 0.10f, 0.04f, 1.0f);                                                            // Set the clear color to a dark greenish tone                 
-    glClear(GL_COLOR_BUFFER_BIT);                                                                       // Clear the framebuffer with the specified color                
-}
-
-/**
- * @brief Ends rendering to the framebuffer.
- * Binds the default framebuffer and clears the color buffer.
- */
-void CRTEffect::endRender() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);                                                               // Unbind the framebuffer to return to the default framebuffer         
-    glClear(GL_COLOR_BUFFER_BIT);                                                                       // Clear the color buffer of the default framebuffer                        
-}
-
 /**
  * @brief Renders the CRT effect using the shader program.
  * This function binds the shader program, sets the texture and time uniform, and draws a quad.
+ * @param screenTexture The rendered scene, read by the effect.
  * @param time The current time, used for animations in the shader.
+ * @param closeAnim TV collapse progress (0=normal, 1=closed); above 0 the collapse variant of the shader is used.
  * This function is responsible for applying the CRT effect to the rendered scene.
  */
-void CRTEffect::render(float time) {
-    glUseProgram(shaderProgram);                                                                        // Use the shader program for rendering
+void CRTEffect::render(GLuint screenTexture, float time, float closeAnim) {
+    const GLuint program = closeAnim > 0.0f ? collapseProgram : shaderProgram;                          // At 0 the collapse shows the whole picture, same as the plain shader
+    glUseProgram(program);                                                                              // Use the shader program for rendering
     glActiveTexture(GL_TEXTURE0);                                                                       // Activate texture unit 0 -> this is where the screen texture will be bound               
     glBindTexture(GL_TEXTURE_2D, screenTexture);                                                        // Bind the screen texture to the active texture unit             
-    glUniform1i(glGetUniformLocation(shaderProgram, "screenTexture"), 0);                               // Set the uniform for the screen texture in the shader program            
-    glUniform1f(glGetUniformLocation(shaderProgram, "time"), time);                                     // Set the uniform for time in the shader program             
+    glUniform1i(glGetUniformLocation(program, "screenTexture"), 0);                                     // Set the uniform for the screen texture in the shader program            
+    glUniform1f(glGetUniformLocation(program, "time"), time);                                           // Set the uniform for time in the shader program             
+    if (program == collapseProgram) {
+        glUniform1f(glGetUniformLocation(program, "closeAnim"), closeAnim);                             // Set the collapse progress
+    }
 
     glBindVertexArray(quadVAO);                                                                         // Bind the vertex array object for the quad          
     glDrawArrays(GL_TRIANGLES, 0, 6);                                                                   // Draw the quad using the vertex array object, specifying the number of vertices to draw                
@@ -138,23 +95,3 @@ void CRTEffect::setupQuad() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));     // Specify the layout of the vertex data for texture coordinates (2 floats per vertex)
     glBindVertexArray(0);                                                                               // Unbind the vertex array object to avoid accidental modifications              
 }
-
-/**
- * @brief Retrieves the width of the rendered screen texture.
- */
-int CRTEffect::getWidth() {
-    int width;
-    glBindTexture(GL_TEXTURE_2D, screenTexture);                                                        // Bind the screen texture to retrieve its parameters          
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);                               // Get the width of the texture at level 0 
-    return width;                                                                                       // Return the width of the texture        
-}
-
-/**
- * @brief Retrieves the height of the rendered screen texture.
- */
-int CRTEffect::getHeight() {
-    int height;
-    glBindTexture(GL_TEXTURE_2D, screenTexture);                                                        // Bind the screen texture to retrieve its parameters          
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);                             // Get the height of the texture at level 0
-    return height;                                                                                      // Return the height of the texture        
-}
\ No newline at end of file
@@ -9,8 +9,10 @@
 
 /**
  * @brief Class for creating a CRT effect using OpenGL.
- * This class handles the setup of a framebuffer, texture, and shader program to render a CRT effect.
- * It includes methods for initializing the effect, resizing the viewport, and rendering the effect.
+ * This class handles the setup of the shader program and fullscreen quad of the CRT effect, and renders
+ * the effect from a screen texture into the bound framebuffer. It is the CRT pass of the RenderGraph in
+ * main.cpp, which owns the render targets. While the TV collapses (closeAnim > 0) a variant of the shader
+ * compiled with TV_COLLAPSE applies the collapse in the same pass, so transitions cost one full screen pass.
  * Also includes constructors and destructors for resource management.
  * 
  * Implemented in CRTEffect.cpp.
@@ -20,20 +22,13 @@ public:
     CRTEffect();
     ~CRTEffect();
     
-    bool initialize(int width, int height);
-    void resize(int width, int height);
-    void beginRender();
-    void endRender();
-    void render(float time);
-    int getWidth();
-    int getHeight();
-    GLuint getScreenTexture() const { return screenTexture; }
+    bool initialize();
+    void render(GLuint screenTexture, float time, float closeAnim = 0.0f);
 
 private:
-    GLuint fbo;
-    GLuint screenTexture;
     GLuint quadVAO, quadVBO;
     GLuint shaderProgram;
+    GLuint collapseProgram;  // shaderProgram with the TV collapse fused in
     
     void setupQuad();
 };
@@ -0,0 +1,171 @@
+#include "CellGridRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "Font.h"
+#include "ShaderManager.h"
+
+/**
+ * @brief Constructor. No GL objects are created until initialize() is called.
+ */
+CellGridRenderer::CellGridRenderer()
+    : vao(0), vbo(0), shaderProgram(0), projectionLoc(-1), originLoc(-1), cellSizeLoc(-1), columnsLoc(-1),
+      scaleLoc(-1), firstRowLoc(-1), bufferCells(0), font(nullptr), fontVersion(0), uploadedCells(0) {}
+
+/**
+ * @brief Destructor. Releases the vertex array, instance buffer and shader program.
+ */
+CellGridRenderer::~CellGridRenderer() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (shaderProgram) glDeleteProgram(shaderProgram);
+}
+
+/**
+ * @brief Loads the shader and creates the vertex array and instance buffer.
+ * @return True on success, false if the shader could not be loaded.
+ */
+bool CellGridRenderer::initialize() {
+    shaderProgram = ShaderManager::loadShader("shaders/terminal.vs.glsl", "shaders/font.fs.glsl");
+    if (!shaderProgram) {
+        std::cerr << "ERROR::CELLGRIDRENDERER:: Failed to load shaders!" << std::endl;
+        return false;
+    }
+    projectionLoc = glGetUniformLocation(shaderProgram, "projection");
+    originLoc = glGetUniformLocation(shaderProgram, "origin");
+    cellSizeLoc = glGetUniformLocation(shaderProgram, "cellSize");
+    columnsLoc = glGetUniformLocation(shaderProgram, "columns");
+    scaleLoc = glGetUniformLocation(shaderProgram, "scale");
+    firstRowLoc = glGetUniformLocation(shaderProgram, "firstRow");
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    for (GLuint attribute = 0; attribute < 4; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    bindInstances(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+/**
+ * @brief Uploads the changed cells and draws the rows in view with one instanced call, two where the view
+ * wraps around the end of the grid's row ring.
+ *
+ * The buffer mirrors the storage rows of the grid, history included, so scrolling the view only moves
+ * where the instances are read from and the row offset of the shader; nothing is uploaded for it.
+ *
+ * @param grid Grid to draw; its changes are marked uploaded.
+ * @param font Font providing glyphs and the atlas texture.
+ * @param projection Projection matrix.
+ * @param origin Pen position (baseline) of the top left cell of the screen.
+ * @param cellSize Cell width and row height in screen pixels.
+ * @param scrollLines How far the view is scrolled back into the history, in rows; fractions scroll
+ * smoothly. Clamped to the history the grid holds.
+ */
+void CellGridRenderer::draw(CellGrid& grid, Font& font, const glm::mat4& projection, glm::vec2 origin,
+                            glm::vec2 cellSize, float scrollLines) {
+    uploadedCells = 0;
+    if (!shaderProgram || grid.size() == 0 || grid.getRows() == 0) return;
+    upload(grid, font);
+
+    // screen row at the top of the view; with a fraction the view covers parts of one more row
+    const float view = -std::clamp(scrollLines, 0.0f, float(grid.getHistoryLines()));
+    const int first = int(std::floor(view));
+    const int last = first + grid.getRows() + (float(first) != view ? 1 : 0);
+
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, &projection[0][0]);
+    glUniform2f(originLoc, origin.x, origin.y);
+    glUniform2f(cellSizeLoc, cellSize.x, cellSize.y);
+    glUniform1i(columnsLoc, grid.getColumns());
+    glUniform1f(scaleLoc, font.getPixelScale());
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, font.getAtlasTexture());
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    for (int row = first; row < last;) {
+        const int storageRow = grid.getStorageRow(row);
+        const int rowsInRun = std::min(last - row, grid.getCapacity() - storageRow);
+        bindInstances(size_t(storageRow) * grid.getColumns());
+        glUniform1f(firstRowLoc, float(row) - view);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(rowsInRun * grid.getColumns()));
+        row += rowsInRun;
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief Points the instance attributes of the vertex array at the buffer, starting at an instance.
+ * Expects the vertex array and buffer to be bound.
+ * @param firstInstance Instance read for gl_InstanceID 0.
+ */
+void CellGridRenderer::bindInstances(size_t firstInstance) {
+    const size_t base = firstInstance * sizeof(Instance);
+    glVertexAttribPointer(0, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(Instance),
+                          (void*)(base + offsetof(Instance, atlasPos)));
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, size)));
+    glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, bearing)));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), (void*)(base + offsetof(Instance, rgba)));
+}
+
+/**
+ * @brief Looks up the glyphs of the changed cells and uploads them.
+ *
+ * The buffer is reallocated when the grid grows; otherwise only the changed range is written. Loading a
+ * glyph may evict the font atlas, in which case everything is looked up once more. If that evicts again
+ * (more distinct glyphs than the atlas holds) the glyphs that resolved are uploaded and the next frame
+ * starts over, rather than evicting forever.
+ */
+void CellGridRenderer::upload(CellGrid& grid, Font& font) {
+    if (this->font != &font || fontVersion != font.getLayoutVersion() || bufferCells != grid.size()) {
+        grid.markAllChanged();
+    }
+    if (!grid.hasChanges()) return;
+
+    size_t begin, end;
+    for (int lookups = 1;; ++lookups) {
+        fontVersion = font.getLayoutVersion();
+        begin = grid.getChangedBegin();
+        end = grid.getChangedEnd();
+        staging.resize(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            const Cell& cell = grid.data()[i];
+            Instance& instance = staging[i - begin];
+            instance = Instance{{0, 0}, {0, 0}, {0, 0}, cell.rgba};
+            if (cell.code == ' ') continue;
+            const Character* ch = font.getGlyph(cell.code);
+            if (!ch) continue;
+            instance.atlasPos[0] = uint16_t(ch->uvMin.x);
+            instance.atlasPos[1] = uint16_t(ch->uvMin.y);
+            instance.size[0] = int16_t(ch->size.x);
+            instance.size[1] = int16_t(ch->size.y);
+            instance.bearing[0] = int16_t(ch->bearing.x);
+            instance.bearing[1] = int16_t(ch->bearing.y);
+        }
+        if (fontVersion == font.getLayoutVersion() || lookups == 2) break;
+        grid.markAllChanged();  // atlas evicted meanwhile
+    }
+    this->font = &font;
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (bufferCells != grid.size()) {
+        // begin..end covers the whole grid here
+        bufferCells = grid.size();
+        glBufferData(GL_ARRAY_BUFFER, bufferCells * sizeof(Instance), staging.data(), GL_DYNAMIC_DRAW);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, begin * sizeof(Instance), staging.size() * sizeof(Instance), staging.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    uploadedCells = end - begin;
+    grid.markUnchanged();
+}
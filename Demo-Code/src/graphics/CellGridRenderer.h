@@ -0,0 +1,65 @@
+#ifndef CELLGRIDRENDERER_H
+#define CELLGRIDRENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "terminal/CellGrid.h"
+
+class Font;
+
+/**
+ * @brief Draws a CellGrid with one instanced draw call, like GPU terminal emulators do.
+ *
+ * Every cell is one instance in a buffer holding the atlas rectangle, metrics and color of its glyph;
+ * the vertex shader (shaders/terminal.vs.glsl) places the quad from gl_InstanceID and the cell size,
+ * and the fragment shader is the distance field shader of Font. Per frame only the changed range of
+ * the grid is looked up in the font and uploaded with glBufferSubData. When the font moves its glyphs
+ * (see Font::getLayoutVersion()) every cell is looked up again.
+ * The buffer holds the grid's scrollback as well; the view into it is chosen per draw, so scrolling
+ * (or a scrolling screen) does not upload anything beyond the rows that were written.
+ *
+ * Implemented in CellGridRenderer.cpp.
+ */
+class CellGridRenderer {
+public:
+    CellGridRenderer();
+    ~CellGridRenderer();
+
+    CellGridRenderer(const CellGridRenderer&) = delete;
+    CellGridRenderer& operator=(const CellGridRenderer&) = delete;
+
+    bool initialize();
+    void draw(CellGrid& grid, Font& font, const glm::mat4& projection, glm::vec2 origin, glm::vec2 cellSize,
+              float scrollLines = 0.0f);
+
+    size_t getUploadedCells() const { return uploadedCells; }
+
+private:
+    /**
+     * @brief Per-cell instance data, 16 bytes.
+     */
+    struct Instance {
+        uint16_t atlasPos[2];  // Top left of the glyph in the atlas, in atlas pixels.
+        int16_t size[2];       // Glyph size in atlas pixels, zero for blank cells.
+        int16_t bearing[2];    // Offset from the pen position to the top left, in atlas pixels.
+        uint32_t rgba;         // Packed color, see CellGrid::packColor().
+    };
+
+    GLuint vao, vbo;
+    GLuint shaderProgram;
+    GLint projectionLoc, originLoc, cellSizeLoc, columnsLoc, scaleLoc, firstRowLoc;
+    size_t bufferCells;             // Size of vbo in instances.
+    std::vector<Instance> staging;  // Instances of the changed range, reused across frames.
+    const Font* font;               // Font the buffer was filled from.
+    uint32_t fontVersion;           // Its layout version at that time.
+    size_t uploadedCells;           // Cells uploaded by the last draw().
+
+    void upload(CellGrid& grid, Font& font);
+    void bindInstances(size_t firstInstance);
+};
+
+#endif // CELLGRIDRENDERER_H
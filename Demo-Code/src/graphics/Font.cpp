@@ -4,37 +4,40 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <cctype>
-#include <glm/gtc/type_ptr.hpp>
+#include <climits>
+#include <cstddef>
+
+#include "core/Utf8.h"
 
 /**
  * @brief Default constructor for Font.
  */
-Font::Font() : VAO(0), VBO(0), shaderProgram(0) {}
+Font::Font() : atlasTexture(0), atlasSize(0), VAO(0), VBO(0), bufferCapacity(0), shaderProgram(0) {}
 
 /**
- * @brief Destructor for Font. Cleans up OpenGL resources and character textures.
+ * @brief Destructor for Font. Cleans up OpenGL resources and the glyph atlas.
  */
 Font::~Font()
 {
-    for (auto &pair : characters)
-    {
-        if (pair.second.textureID)
-            glDeleteTextures(1, &pair.second.textureID);
-    }
-    characters.clear();
+    if (atlasTexture)
+        glDeleteTextures(1, &atlasTexture);
+    glyphs.clear();
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
     glDeleteProgram(shaderProgram);
 }
 
 /**
- * @brief Loads a font from the specified file and prepares glyph textures for rendering.
+ * @brief Loads a font from the specified file and prepares the glyph atlas for rendering.
  *
- * This function initializes the FreeType library, loads the font face from the given file path,
- * and generates OpenGL textures for the first 128 ASCII characters. It also sets up the necessary
- * OpenGL buffers and vertex array objects for rendering text. Any previously loaded character
- * textures are cleared before loading the new font.
+ * This function opens the font in the glyph cache (kept open afterwards) and binds the glyph set for the
+ * render height the pixel height needs. No glyph is rasterized here: printable ASCII missing from the set
+ * is handed to the cache's worker threads and arrives over the next frames, and renderText() and
+ * getTextWidth() rasterize any other glyph the first time they meet it. The OpenGL buffers, vertex array
+ * object, shader and atlas texture are created on the first call only. Later size changes only need
+ * setPixelHeight().
  *
  * @param fontPath The file path to the font file (e.g., .ttf or .otf).
  * @param pixelHeight The desired pixel height for the loaded glyphs.
@@ -45,86 +48,272 @@ Font::~Font()
  */
 bool Font::load(const std::string &fontPath, int pixelHeight)
 {
-    // clear old character textures
-    for (auto &pair : characters)
+    if (!cache.open(fontPath))
+        return false;
+
+    this->pixelHeight = pixelHeight;
+    useGlyphSet(cache.get(fontSdfPixelHeight(pixelHeight)));
+    std::string ascii;
+    for (char c = ' '; c < 127; ++c)
+        ascii += c;
+    preload(ascii);
+    if (VAO)
+        return true; // buffers and shader survive reloading the font
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    bufferCapacity = 0; // allocated by the first flush()
+    setVertexLayout();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    return initShader("shaders/font.vs.glsl", "shaders/font.fs.glsl");
+}
+
+/**
+ * @brief Describes TextVertex to the vertex array object and buffer currently bound.
+ *
+ * Shared by the frame's batch and every TextRun.
+ */
+void Font::setVertexLayout()
+{
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)offsetof(TextVertex, pos));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex), (void *)offsetof(TextVertex, color));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)offsetof(TextVertex, index));
+}
+
+/**
+ * @brief Switches to a glyph set: uploads its atlas and rebuilds the character table from its metrics.
+ *
+ * Text runs laid out with the previous set are invalidated.
+ *
+ * @param set Glyph set from the cache.
+ */
+void Font::useGlyphSet(std::shared_ptr<GlyphSet> set)
+{
+    glyphSet = std::move(set);
+    ++layoutVersion;
+    uploadAtlas();
+
+    glyphs.clear();
+    for (const auto &glyph : glyphSet->glyphs)
+        glyphs.insert(glyph.second);
+    pixelScale = float(pixelHeight) / float(glyphSet->pixelHeight);
+}
+
+/**
+ * @brief Uploads the whole atlas of the current glyph set, re-specifying the texture storage.
+ *
+ * Used when switching sets and when the atlas grows. The texture object is created once.
+ */
+void Font::uploadAtlas()
+{
+    const GlyphAtlasImage &atlas = glyphSet->atlas.getImage();
+    atlasSize = glm::ivec2(atlas.width, atlas.height);
+    std::cout << "Font SDF atlas: " << atlas.width << "x" << atlas.height << " with " << glyphSet->glyphs.size()
+              << " glyphs at " << glyphSet->pixelHeight << " px" << std::endl;
+
+    if (!atlasTexture)
+        glGenTextures(1, &atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlas.width, atlas.height, 0, GL_RED, GL_UNSIGNED_BYTE,
+                 atlas.pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief Uploads the atlas rows and columns of one glyph, including its padding, with glTexSubImage2D.
+ *
+ * The padding is uploaded too because an emptied atlas may still hold old glyphs there on the GPU.
+ *
+ * @param glyph Glyph just placed in the current atlas.
+ */
+void Font::uploadGlyph(const GlyphBitmap &glyph)
+{
+    if (glyph.size.x <= 0 || glyph.size.y <= 0)
+        return;
+    const int pad = GLYPH_ATLAS_PADDING;
+    uploadRegion(glyph.atlasPos.x - pad, glyph.atlasPos.y - pad, glyph.atlasPos.x + glyph.size.x + pad,
+                 glyph.atlasPos.y + glyph.size.y + pad);
+}
+
+/**
+ * @brief Uploads a rectangle of the current atlas with one glTexSubImage2D.
+ *
+ * @param x0 Left column, clamped to the atlas.
+ * @param y0 Top row, clamped to the atlas.
+ * @param x1 Column past the right edge, clamped to the atlas.
+ * @param y1 Row past the bottom edge, clamped to the atlas.
+ */
+void Font::uploadRegion(int x0, int y0, int x1, int y1)
+{
+    const GlyphAtlasImage &atlas = glyphSet->atlas.getImage();
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, atlas.width);
+    y1 = std::min(y1, atlas.height);
+    if (x1 <= x0 || y1 <= y0)
+        return;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, atlas.width);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x0, y0, x1 - x0, y1 - y0, GL_RED, GL_UNSIGNED_BYTE,
+                    &atlas.pixels[size_t(y0) * atlas.width + x0]);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+/**
+ * @brief Rasterizes a glyph the text needs for the first time and adds it to the atlas and the table.
+ *
+ * Glyphs the workers finished in the meantime are added first, in case the code is among them.
+ * If the atlas is full, the text queued so far is drawn with the current atlas, then every glyph is
+ * evicted and the atlas starts over; glyphs still in use come back on demand and text runs are laid out
+ * again. Codes FreeType cannot
+ * render are recorded without pixels so they are not tried again.
+ *
+ * @param code Unicode code point.
+ * @return The glyph.
+ */
+const Character *Font::loadGlyph(uint32_t code)
+{
+    if (addPrefetched())
     {
-        if (pair.second.textureID)
-            glDeleteTextures(1, &pair.second.textureID);
+        if (const Character *arrived = glyphs.find(code))
+            return arrived;
     }
-    characters.clear();
-    
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft))
+
+    GlyphBitmap glyph;
+    if (!cache.rasterize(glyphSet->pixelHeight, code, glyph))
     {
-        std::cerr << "Failed to init FreeType library\n";
-        return false;
+        glyph = GlyphBitmap{};
+        glyph.code = code;
     }
 
-    FT_Face face;
-    if (FT_New_Face(ft, fontPath.c_str(), 0, &face))
+    if (!glyphSet->add(glyph))
     {
-        std::cerr << "Failed to load font: " << fontPath << "\n";
-        FT_Done_FreeType(ft);
-        return false;
+        std::cout << "Font SDF atlas full with " << glyphSet->glyphs.size() << " glyphs, evicting all" << std::endl;
+        drawPending();
+        glyphSet->clear();
+        glyphs.clear();
+        ++layoutVersion;
+        if (!glyphSet->add(glyph))
+        {
+            std::cerr << "Glyph " << code << " does not fit into the atlas\n";
+            glyph = GlyphBitmap{};
+            glyph.code = code;
+            glyphSet->add(glyph);
+        }
     }
 
-    FT_Set_Pixel_Sizes(face, 0, pixelHeight);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    if (glyphSet->atlas.getImage().height != atlasSize.y)
+        uploadAtlas(); // grown; positions are unchanged, so queued quads stay valid
+    else
+        uploadGlyph(glyph);
+    return glyphs.insert(glyph);
+}
+
+/**
+ * @brief Looks up a glyph, rasterizing it if it is not in the atlas yet.
+ *
+ * @param code Unicode code point.
+ * @return The glyph, or nullptr if no font is loaded.
+ */
+const Character *Font::getGlyph(uint32_t code)
+{
+    if (!glyphSet)
+        return nullptr;
+    const Character *glyph = glyphs.find(code);
+    return glyph ? glyph : loadGlyph(code);
+}
+
+/**
+ * @brief Adds the glyphs the cache's worker threads finished since the last call to the atlas and the table.
+ *
+ * All of them are uploaded together: with one glTexSubImage2D of the rectangle around them, or with
+ * the whole atlas if it had to grow. Glyphs loaded on demand in the meantime are skipped, and once the
+ * atlas is full the rest is dropped; those come back on demand.
+ *
+ * @return True if any glyph was added.
+ */
+bool Font::addPrefetched()
+{
+    std::vector<RasterizedGlyph> arrived = cache.collect(glyphSet->pixelHeight);
+    if (arrived.empty())
+        return false;
 
-    for (unsigned char c = 0; c < 128; c++)
+    const int pad = GLYPH_ATLAS_PADDING;
+    int x0 = INT_MAX, y0 = INT_MAX, x1 = 0, y1 = 0;
+    size_t added = 0;
+    for (RasterizedGlyph &result : arrived)
     {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-        {
-            std::cerr << "Failed to load glyph: " << (int)c << " '" << c << "'\n";
+        GlyphBitmap &glyph = result.glyph;
+        if (glyphs.find(glyph.code))
             continue;
-        }
-
-        GLuint tex = 0;
-        if (face->glyph->bitmap.buffer)
+        if (!glyphSet->add(glyph))
+            break;
+        glyphs.insert(glyph);
+        ++added;
+        if (glyph.size.x > 0 && glyph.size.y > 0)
         {
-            glGenTextures(1, &tex);
-            glBindTexture(GL_TEXTURE_2D, tex);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,
-                         face->glyph->bitmap.width,
-                         face->glyph->bitmap.rows,
-                         0, GL_RED, GL_UNSIGNED_BYTE,
-                         face->glyph->bitmap.buffer);
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            x0 = std::min(x0, glyph.atlasPos.x - pad);
+            y0 = std::min(y0, glyph.atlasPos.y - pad);
+            x1 = std::max(x1, glyph.atlasPos.x + glyph.size.x + pad);
+            y1 = std::max(y1, glyph.atlasPos.y + glyph.size.y + pad);
         }
-
-        Character character = {
-            tex,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<GLuint>(face->glyph->advance.x)};
-
-        characters.insert(std::make_pair(c, character));
     }
+    if (added == 0)
+        return false;
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    if (glyphSet->atlas.getImage().height != atlasSize.y)
+        uploadAtlas();
+    else
+        uploadRegion(x0, y0, x1, y1);
+    return true;
+}
 
-    return initShader("shaders/font.vs.glsl", "shaders/font.fs.glsl");
+/**
+ * @brief Has the glyphs of a text that are not in the atlas yet rasterized on the cache's worker threads.
+ *
+ * Call it with text that is about to be drawn, e.g. the strings of a scene when it starts, so the first
+ * frame does not rasterize them one by one. The glyphs are added by a later flush() or renderText().
+ *
+ * @param text UTF-8 text.
+ */
+void Font::preload(const std::string &text)
+{
+    if (!glyphSet)
+        return;
+    std::vector<uint32_t> codes;
+    for (size_t i = 0; i < text.size();)
+    {
+        uint32_t code = decodeUtf8(text, i);
+        if (!glyphs.find(code))
+            codes.push_back(code);
+    }
+    std::sort(codes.begin(), codes.end());
+    codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+    cache.prefetch(glyphSet->pixelHeight, codes);
 }
 
 /**
- * @brief Renders the given text string at the specified position, scale, and color.
+ * @brief Queues the given text string at the specified position, scale, and color.
+ *
+ * The glyph quads are appended to the frame's vertex array with the color baked into every vertex;
+ * nothing is drawn until flush(), which submits the text of all calls at once.
  *
- * @param text The text string to render.
+ * @param text The UTF-8 text string to render.
  * @param x The x-coordinate of the text's starting position.
  * @param y The y-coordinate of the text's baseline.
  * @param scale The scaling factor for the text size.
@@ -132,57 +321,189 @@ bool Font::load(const std::string &fontPath, int pixelHeight)
  */
 void Font::renderText(const std::string &text, float x, float y, float scale, const glm::vec3 &color)
 {
-    glUseProgram(shaderProgram);
-    glUniform3fv(glGetUniformLocation(shaderProgram, "textColor"), 1, glm::value_ptr(color));
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    if (!glyphSet)
+        return; // not loaded
+    layoutText(text, x, y, scale, color, pending);
+}
+
+/**
+ * @brief Lays out a text string into glyph quads.
+ *
+ * The text is decoded from UTF-8 and glyphs not in the atlas yet are rasterized on the way. Loading a
+ * glyph may evict the atlas, which bumps the layout version; quads appended before that are stale then.
+ * Every quad is tagged with the byte offset of its character, so the vertex shader can reveal a prefix
+ * of the text. With cursor set, an underscore quad tagged -(offset + 1) is laid out in front of every
+ * character and after the last one; the shader shows the one at the end of the revealed prefix.
+ *
+ * @param text The UTF-8 text string to lay out.
+ * @param x The x-coordinate of the text's starting position.
+ * @param y The y-coordinate of the text's baseline.
+ * @param scale The scaling factor for the text size.
+ * @param color The color of the text (RGB).
+ * @param out Receives six vertices per visible glyph, appended.
+ * @param cursor Whether to lay out the cursor quads too.
+ * @return Horizontal pen advance over the text.
+ */
+float Font::layoutText(const std::string &text, float x, float y, float scale, const glm::vec3 &color,
+                       std::vector<TextVertex> &out, bool cursor)
+{
+    if (!glyphSet)
+        return 0.0f;
+    const float startX = x;
+    scale *= pixelScale; // glyph metrics are in atlas pixels
+    glm::vec3 c8 = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    const uint8_t rgba[4] = {uint8_t(c8.x), uint8_t(c8.y), uint8_t(c8.z), 255};
+
+    const Character *space = glyphs.find(' ');
+    if (!space)
+        space = loadGlyph(' ');
+    const float tabAdvance = space->advance * 4.0f; // Tab = 4 spaces
+    Character underscore;
+    if (cursor)
+    {
+        const Character *found = glyphs.find('_');
+        underscore = found ? *found : *loadGlyph('_'); // copied, loading more glyphs moves the table
+    }
 
-    for (char c : text)
+    for (size_t i = 0; i < text.size();)
     {
-        if (c == '\t')
+        const float index = float(i);
+        if (cursor)
+            pushQuad(underscore, x, y, scale, rgba, -index - 1.0f, out);
+
+        uint32_t code = decodeUtf8(text, i);
+        if (code == '\t')
         {
-            // Fallback to space if tab isn't available
-            Character space = characters.count(' ') ? characters[' '] : Character{0, {0, 0}, {0, 0}, 10 << 6};
-            x += (space.advance >> 6) * scale * 4; // Tab = 4 spaces
+            x += tabAdvance * scale;
             continue;
         }
 
-        if (characters.find(c) == characters.end())
-            continue;
+        const Character *glyph = glyphs.find(code);
+        if (!glyph)
+            glyph = loadGlyph(code);
+        const Character &ch = *glyph;
 
-        Character ch = characters[c];
+        if (!(code < 0x80 && isspace(static_cast<int>(code)) && code != ' '))
+            pushQuad(ch, x, y, scale, rgba, index, out);
+        x += ch.advance * scale;
+    }
+    if (cursor)
+        pushQuad(underscore, x, y, scale, rgba, -float(text.size()) - 1.0f, out);
+    return x - startX;
+}
 
-        if (isspace(c) && c != ' ') {
-            x += (ch.advance >> 6) * scale;
-            continue;
-        }
+/**
+ * @brief Appends the two triangles of a glyph at a pen position; glyphs without pixels add nothing.
+ *
+ * @param ch Glyph.
+ * @param x Pen position.
+ * @param y Baseline.
+ * @param scale Scale from atlas to screen pixels.
+ * @param rgba Vertex color.
+ * @param index Tag for the reveal in the vertex shader, see layoutText().
+ * @param out Receives the vertices.
+ */
+void Font::pushQuad(const Character &ch, float x, float y, float scale, const uint8_t rgba[4], float index,
+                    std::vector<TextVertex> &out)
+{
+    float xpos = x + ch.bearing.x * scale;
+    float ypos = y - (ch.size.y - ch.bearing.y) * scale;
+
+    float w = ch.size.x * scale;
+    float h = ch.size.y * scale;
+    if (w <= 0 || h <= 0)
+        return;
+
+    const glm::vec4 corners[6] = {
+        {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y},
+        {xpos, ypos, ch.uvMin.x, ch.uvMax.y},
+        {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y},
+        {xpos, ypos + h, ch.uvMin.x, ch.uvMin.y},
+        {xpos + w, ypos, ch.uvMax.x, ch.uvMax.y},
+        {xpos + w, ypos + h, ch.uvMax.x, ch.uvMin.y}};
+    for (const auto &corner : corners)
+        out.push_back({corner, {rgba[0], rgba[1], rgba[2], rgba[3]}, index});
+}
 
-        float xpos = x + ch.bearing.x * scale;
-        float ypos = y - (ch.size.y - ch.bearing.y) * scale;
+/**
+ * @brief Queues a text run to be drawn by the next flush(), after the batched text.
+ *
+ * @param run Laid out run; must stay alive until the flush.
+ * @param x X position of the run's origin.
+ * @param y Y position of the run's baseline.
+ * @param visibleBytes Length of the revealed prefix of the run's text in bytes.
+ * @param cursor Whether to show the cursor after the revealed prefix.
+ */
+void Font::queueRun(const TextRun &run, float x, float y, size_t visibleBytes, bool cursor)
+{
+    runs.push_back({&run, glm::vec2(x, y), float(visibleBytes), cursor});
+}
 
-        float w = ch.size.x * scale;
-        float h = ch.size.y * scale;
+/**
+ * @brief Draws all text queued since the last flush with a single draw call.
+ *
+ * Afterwards glyphs and glyph sets that finished rasterizing in the background are added or swapped in,
+ * so the quads queued in one frame always match the atlas they are drawn with.
+ *
+ * @return Number of glyph quads drawn.
+ */
+size_t Font::flush()
+{
+    size_t quads = drawPending();
+    if (glyphSet)
+        addPrefetched();
+    setPixelHeight(pixelHeight); // picks up a background rasterization
+    return quads;
+}
 
-        if (w > 0 && h > 0)
-        {
-            float vertices[6][4] = {
-                {xpos, ypos + h, 0.0f, 0.0f},
-                {xpos, ypos, 0.0f, 1.0f},
-                {xpos + w, ypos, 1.0f, 1.0f},
-                {xpos, ypos + h, 0.0f, 0.0f},
-                {xpos + w, ypos, 1.0f, 1.0f},
-                {xpos + w, ypos + h, 1.0f, 0.0f}};
-            glBindTexture(GL_TEXTURE_2D, ch.textureID);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
+/**
+ * @brief Submits the queued glyph quads and text runs and clears both queues.
+ *
+ * The vertex buffer is orphaned before the upload so the driver can hand out fresh storage instead of
+ * waiting for the previous frame's draw; it only grows. Each text run is one more draw from its own
+ * buffer with its position, revealed prefix and cursor in uniforms. Uses the projection currently set on
+ * the shader.
+ *
+ * @return Number of glyph quads drawn.
+ */
+size_t Font::drawPending()
+{
+    if (pending.empty() && runs.empty())
+        return 0;
 
-        x += (ch.advance >> 6) * scale;
+    glUseProgram(shaderProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    size_t vertices = pending.size();
+    if (!pending.empty())
+    {
+        glUniform2f(offsetLocation, 0.0f, 0.0f);
+        glUniform1f(visibleLocation, TEXT_ALL_VISIBLE);
+        glUniform1i(cursorLocation, 0);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        if (pending.size() > bufferCapacity)
+            bufferCapacity = pending.size() * 2;
+        glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, pending.size() * sizeof(TextVertex), pending.data());
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(pending.size()));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    for (const QueuedRun &queued : runs)
+    {
+        glUniform2f(offsetLocation, queued.offset.x, queued.offset.y);
+        glUniform1f(visibleLocation, queued.visibleBytes);
+        glUniform1i(cursorLocation, queued.cursor ? 1 : 0);
+        glBindVertexArray(queued.run->vao);
+        glDrawArrays(GL_TRIANGLES, 0, queued.run->vertexCount);
+        vertices += queued.run->vertexCount;
     }
-
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
+
+    pending.clear();
+    runs.clear();
+    return vertices / 6;
 }
 
 /**
@@ -216,6 +537,9 @@ bool Font::initShader(const std::string &vertexPath, const std::string &fragment
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 
+    offsetLocation = glGetUniformLocation(shaderProgram, "offset");
+    visibleLocation = glGetUniformLocation(shaderProgram, "visibleBytes");
+    cursorLocation = glGetUniformLocation(shaderProgram, "cursor");
     return true;
 }
 
@@ -236,22 +560,54 @@ std::string Font::loadFileToString(const std::string &path)
 /**
  * @brief Calculates the width of the given text string when rendered at the specified scale.
  *
- * @param text The text string to measure.
+ * @param text The UTF-8 text string to measure.
  * @param scale The scaling factor for the text size.
  * @return The width of the text in pixels.
  */
-float Font::getTextWidth(const std::string &text, float scale) const
+float Font::getTextWidth(const std::string &text, float scale)
 {
+    if (!glyphSet)
+        return 0.0f;
+    scale *= pixelScale;
     float width = 0.0f;
-    for (char c : text)
+    for (size_t i = 0; i < text.size();)
     {
-        auto it = characters.find(c);
-        if (it != characters.end())
-            width += (it->second.advance >> 6) * scale;
+        uint32_t code = decodeUtf8(text, i);
+        const Character *glyph = glyphs.find(code);
+        if (!glyph)
+            glyph = loadGlyph(code);
+        width += glyph->advance * scale;
     }
     return width;
 }
 
+/**
+ * @brief Changes the pixel height text is drawn at.
+ *
+ * The distance field atlas covers a range of sizes, so usually this only updates the scale applied to
+ * the glyph metrics. When the size needs another render height, the set is taken from the cache or
+ * requested from a background rasterization; until it arrives the current atlas is scaled instead.
+ *
+ * @param pixelHeight The desired pixel height for the glyphs.
+ */
+void Font::setPixelHeight(int pixelHeight)
+{
+    this->pixelHeight = pixelHeight;
+    if (!glyphSet)
+        return;
+    int sdfPixelHeight = fontSdfPixelHeight(pixelHeight);
+    if (sdfPixelHeight != glyphSet->pixelHeight && pending.empty() && runs.empty())
+    {
+        // the new set starts with the glyphs of the current one
+        if (std::shared_ptr<GlyphSet> set = cache.request(sdfPixelHeight, glyphSet->codes()))
+            useGlyphSet(std::move(set));
+    }
+    float scale = float(pixelHeight) / float(glyphSet->pixelHeight);
+    if (scale != pixelScale)
+        ++layoutVersion; // text runs are laid out in screen pixels
+    pixelScale = scale;
+}
+
 /**
  * @brief Sets the screen width for text rendering.
  *
@@ -4,25 +4,34 @@
 #include <GLFW/glfw3.h>
 #include <ft2build.h>
 
+#include <cstdint>
 #include <glm/glm.hpp>
-#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include FT_FREETYPE_H
 
-/**
- * @brief Stores all relevant information for a single character glyph.
- */
-struct Character {
-    GLuint textureID;    ///< OpenGL texture ID for the glyph.
-    glm::ivec2 size;     ///< Size of the glyph in pixels.
-    glm::ivec2 bearing;  ///< Offset from baseline to left/top of glyph.
-    GLuint advance;      ///< Offset to advance to next glyph.
-};
+#include "FontCache.h"
+#include "GlyphTable.h"
+#include "TextRun.h"
 
 /**
  * @brief Font rendering class using FreeType and OpenGL.
  *
  * Provides functionality to load fonts, render text, and manage font-related OpenGL resources.
+ * Text is UTF-8. All glyphs live in one atlas texture (see GlyphAtlas), so drawing text never switches
+ * textures. Glyphs are rasterized the first time they are drawn or measured and uploaded into the atlas
+ * with glTexSubImage2D; the atlas grows when it runs out of room and is emptied when it cannot grow.
+ * Glyphs known to be needed soon (printable ASCII, preload()) are rasterized on worker threads instead
+ * and uploaded in one batch per frame.
+ * The atlas holds signed distance fields (see fontSdfPixelHeight()); the fragment shader turns them into
+ * sharp edges at any scale, so changing the pixel height is mostly a new scale factor. The glyph sets
+ * come from a FontCache that keeps the face open; a size needing a larger render height is rasterized in
+ * the background and swapped in after a flush(), while text keeps drawing from the current atlas.
+ * The vertex array, buffer and shader are created once.
+ * renderText() only queues glyph quads with a per-vertex color; flush() draws everything queued in the
+ * frame with one upload and one draw call. Text that stays the same over many frames can be laid out once
+ * into a TextRun instead, which flush() draws from its own buffer.
  */
 class Font {
    public:
@@ -37,7 +46,7 @@ class Font {
     ~Font();
 
     /**
-     * @brief Loads a font from file and prepares glyph textures.
+     * @brief Opens a font file and prepares the atlas texture; glyphs are rasterized when first used.
      * @param fontPath Path to the font file (e.g., .ttf).
      * @param pixelHeight Desired pixel height for glyphs.
      * @return True if loading was successful, false otherwise.
@@ -45,8 +54,26 @@ class Font {
     bool load(const std::string& fontPath, int pixelHeight);
 
     /**
-     * @brief Renders a text string at the specified position, scale, and color.
-     * @param text The text to render.
+     * @brief Rasterizes the glyphs of a text in the background ahead of drawing it.
+     * @param text UTF-8 text.
+     */
+    void preload(const std::string& text);
+
+    /**
+     * @brief Changes the pixel height text is drawn at. Never blocks on rasterization.
+     * @param pixelHeight Desired pixel height for glyphs.
+     */
+    void setPixelHeight(int pixelHeight);
+
+    /**
+     * @brief Gets the pixel height text is drawn at.
+     * @return Pixel height.
+     */
+    int getPixelHeight() const { return pixelHeight; }
+
+    /**
+     * @brief Queues a text string at the specified position, scale, and color; drawn by flush().
+     * @param text The text to render, UTF-8 encoded.
      * @param x X position.
      * @param y Y position (baseline).
      * @param scale Scaling factor.
@@ -54,6 +81,37 @@ class Font {
      */
     void renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
 
+    /**
+     * @brief Looks up a glyph for drawing it elsewhere (e.g. CellGridRenderer), rasterizing it if needed.
+     * The pointer is valid until the next glyph is loaded; check getLayoutVersion() for evictions.
+     * @param code Unicode code point.
+     * @return The glyph, or nullptr if no font is loaded.
+     */
+    const Character* getGlyph(uint32_t code);
+
+    /**
+     * @brief Returns the atlas texture the glyph texture coordinates refer to (in atlas pixels).
+     */
+    GLuint getAtlasTexture() const { return atlasTexture; }
+
+    /**
+     * @brief Scale from atlas pixels to screen pixels at the current pixel height.
+     */
+    float getPixelScale() const { return pixelScale; }
+
+    /**
+     * @brief Counter that changes whenever laid out glyph quads become stale: when the atlas is replaced or
+     * emptied, or the pixel height changes. TextRun compares it to decide when to lay out again.
+     * @return Layout version.
+     */
+    uint32_t getLayoutVersion() const { return layoutVersion; }
+
+    /**
+     * @brief Draws all text queued since the last flush in one draw call, plus one per queued TextRun.
+     * @return Number of glyph quads drawn.
+     */
+    size_t flush();
+
     /**
      * @brief Returns the OpenGL shader program used for font rendering.
      * @return Shader program ID.
@@ -62,11 +120,12 @@ class Font {
 
     /**
      * @brief Calculates the width of the given text string at the specified scale.
-     * @param text The text to measure.
+     * Rasterizes glyphs not seen before, like renderText().
+     * @param text The text to measure, UTF-8 encoded.
      * @param scale Scaling factor.
      * @return Width in pixels.
      */
-    float getTextWidth(const std::string& text, float scale = 1.0f) const;
+    float getTextWidth(const std::string& text, float scale = 1.0f);
 
     /**
      * @brief Sets the screen width for text rendering.
@@ -80,12 +139,67 @@ class Font {
      */
     int getScreenWidth() const;
 
+    /**
+     * @brief Returns the size of the glyph atlas texture.
+     * @return Width and height in pixels.
+     */
+    glm::ivec2 getAtlasSize() const { return atlasSize; }
+
    private:
-    std::map<char, Character> characters;
+    friend class TextRun;
+
+    /**
+     * @brief Vertex of a queued glyph quad.
+     */
+    struct TextVertex {
+        glm::vec4 pos;       // Screen position and atlas texture coordinates in atlas pixels.
+        uint8_t color[4];    // RGBA, normalized by the vertex fetch.
+        float index;         // Byte offset of the character in its text, -(offset + 1) for cursor quads.
+    };
+
+    static constexpr float TEXT_ALL_VISIBLE = 1e9f;  // Reveal uniform that shows every glyph.
+
+    /**
+     * @brief Text run queued for the next flush.
+     */
+    struct QueuedRun {
+        const TextRun* run;
+        glm::vec2 offset;    // Position of the run's origin.
+        float visibleBytes;  // Revealed prefix of the run's text.
+        bool cursor;         // Cursor shown after the prefix.
+    };
+
+    GlyphTable glyphs;                         // Metrics and texture coordinates of the current set.
+    FontCache cache;                           // Open font and glyph sets by render height.
+    std::shared_ptr<GlyphSet> glyphSet;        // Set currently in atlasTexture.
+    GLuint atlasTexture;      // Single channel texture holding every glyph.
+    glm::ivec2 atlasSize;     // Size of atlasTexture in pixels, follows the atlas of glyphSet.
     GLuint VAO, VBO;
+    size_t bufferCapacity;            // Size of VBO in vertices.
+    std::vector<TextVertex> pending;  // Glyph quads queued since the last flush.
+    std::vector<QueuedRun> runs;      // Text runs queued since the last flush.
     GLuint shaderProgram;
+    GLint offsetLocation = -1;        // Location of the offset uniform.
+    GLint visibleLocation = -1;       // Location of the visibleBytes uniform.
+    GLint cursorLocation = -1;        // Location of the cursor uniform.
+    uint32_t layoutVersion = 0;       // See getLayoutVersion().
     int screenWidth = 800;  // Default screen width
+    int pixelHeight = FONT_SDF_PIXEL_HEIGHT;  // Pixel height text is drawn at.
+    float pixelScale = 1.0f;                 // pixelHeight / glyphSet->pixelHeight.
 
+    void useGlyphSet(std::shared_ptr<GlyphSet> set);
+    const Character* loadGlyph(uint32_t code);
+    void uploadAtlas();
+    void uploadGlyph(const GlyphBitmap& glyph);
+    void uploadRegion(int x0, int y0, int x1, int y1);
+    bool addPrefetched();
+    size_t drawPending();
+    float layoutText(const std::string& text, float x, float y, float scale, const glm::vec3& color,
+                     std::vector<TextVertex>& out, bool cursor = false);
+    static void pushQuad(const Character& ch, float x, float y, float scale, const uint8_t rgba[4], float index,
+                         std::vector<TextVertex>& out);
+    void queueRun(const TextRun& run, float x, float y, size_t visibleBytes, bool cursor);
+    static void setVertexLayout();
     bool initShader(const std::string& vertexPath, const std::string& fragmentPath);
     std::string loadFileToString(const std::string& path);
 };
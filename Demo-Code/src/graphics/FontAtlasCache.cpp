@@ -0,0 +1,153 @@
+#include "FontAtlasCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "core/MappedFile.h"
+
+namespace {
+
+constexpr char FONT_ATLAS_CACHE_MAGIC[4] = {'R', 'T', 'F', 'A'};
+
+/**
+ * @brief Size of a cache file with the given header, used to reject truncated files.
+ */
+size_t cacheFileSize(const FontAtlasCacheHeader& header) {
+    return sizeof(FontAtlasCacheHeader) + size_t(header.glyphCount) * sizeof(FontAtlasCacheGlyph) +
+           size_t(header.segmentCount) * sizeof(SkylinePacker::Segment) + size_t(header.width) * header.height;
+}
+
+}  // namespace
+
+/**
+ * @brief Cache file of a font at one render height: "<fontPath>.<sdfPixelHeight>.atlas".
+ */
+std::string fontAtlasCachePath(const std::string& fontPath, int sdfPixelHeight) {
+    return fontPath + "." + std::to_string(sdfPixelHeight) + ".atlas";
+}
+
+/**
+ * @brief Load a glyph set from its baked cache file with a single mapping of the file.
+ * @param fontPath Path to the font file the set belongs to.
+ * @param sourceHash Hash of the font file bytes, see FontAtlasCacheHeader::sourceHash.
+ * @param sdfPixelHeight Render height.
+ * @return The set (not dirty), or nullptr.
+ */
+std::shared_ptr<GlyphSet> loadFontAtlasCache(const std::string& fontPath, uint64_t sourceHash, int sdfPixelHeight) {
+    const std::string cachePath = fontAtlasCachePath(fontPath, sdfPixelHeight);
+
+    MappedFile cache;
+    if (!cache.open(cachePath) || cache.size() < sizeof(FontAtlasCacheHeader)) return nullptr;
+
+    FontAtlasCacheHeader header;
+    std::memcpy(&header, cache.data(), sizeof(header));
+    bool valid = std::memcmp(header.magic, FONT_ATLAS_CACHE_MAGIC, sizeof(FONT_ATLAS_CACHE_MAGIC)) == 0 &&
+                 header.version == FONT_ATLAS_CACHE_VERSION && header.sourceHash == sourceHash &&
+                 header.format == FONT_ATLAS_FORMAT_SDF8 && header.pixelHeight == sdfPixelHeight &&
+                 header.spread == fontSdfSpread(sdfPixelHeight) && header.width > 0 && header.height > 0 &&
+                 cache.size() == cacheFileSize(header);
+    if (!valid) {
+        std::cerr << "Font atlas cache is stale, rebuilding: " << cachePath << "\n";
+        return nullptr;
+    }
+
+    const unsigned char* data = cache.data() + sizeof(FontAtlasCacheHeader);
+    const FontAtlasCacheGlyph* records = reinterpret_cast<const FontAtlasCacheGlyph*>(data);
+    data += size_t(header.glyphCount) * sizeof(FontAtlasCacheGlyph);
+    const SkylinePacker::Segment* segments = reinterpret_cast<const SkylinePacker::Segment*>(data);
+    data += size_t(header.segmentCount) * sizeof(SkylinePacker::Segment);
+
+    GlyphAtlasImage image;
+    image.width = header.width;
+    image.height = header.height;
+    image.pixels.assign(data, data + size_t(header.width) * header.height);
+    image.glyphArea = header.glyphArea;
+
+    auto set = std::make_shared<GlyphSet>(sdfPixelHeight);
+    std::vector<SkylinePacker::Segment> skyline(segments, segments + header.segmentCount);
+    if (!set->atlas.restore(std::move(image), skyline, header.usedArea)) {
+        std::cerr << "Font atlas cache is stale, rebuilding: " << cachePath << "\n";
+        return nullptr;
+    }
+
+    set->glyphs.reserve(header.glyphCount);
+    for (uint32_t i = 0; i < header.glyphCount; ++i) {
+        const FontAtlasCacheGlyph& record = records[i];
+        GlyphBitmap& glyph = set->glyphs[record.code];
+        glyph.code = record.code;
+        glyph.size = glm::ivec2(record.width, record.height);
+        glyph.bearing = glm::ivec2(record.bearingX, record.bearingY);
+        glyph.advance = record.advance;
+        glyph.atlasPos = glm::ivec2(record.atlasX, record.atlasY);
+    }
+    set->dirty = false;
+    return set;
+}
+
+/**
+ * @brief Write the baked cache file of a glyph set.
+ *
+ * Like the map cache, the file is written under a temporary name and renamed afterwards.
+ *
+ * @param fontPath Path to the font file the set belongs to.
+ * @param sourceHash Hash of the font file bytes.
+ * @param set Glyph set to save.
+ * @return True on success, false otherwise.
+ */
+bool writeFontAtlasCache(const std::string& fontPath, uint64_t sourceHash, const GlyphSet& set) {
+    const std::string cachePath = fontAtlasCachePath(fontPath, set.pixelHeight);
+    const GlyphAtlasImage& image = set.atlas.getImage();
+    const std::vector<SkylinePacker::Segment>& skyline = set.atlas.getPacker().getSkyline();
+
+    FontAtlasCacheHeader header = {};
+    std::memcpy(header.magic, FONT_ATLAS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = FONT_ATLAS_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.format = FONT_ATLAS_FORMAT_SDF8;
+    header.pixelHeight = set.pixelHeight;
+    header.spread = fontSdfSpread(set.pixelHeight);
+    header.width = image.width;
+    header.height = image.height;
+    header.glyphCount = static_cast<uint32_t>(set.glyphs.size());
+    header.segmentCount = static_cast<uint32_t>(skyline.size());
+    header.glyphArea = image.glyphArea;
+    header.usedArea = set.atlas.getPacker().getUsedArea();
+
+    std::vector<FontAtlasCacheGlyph> records;
+    records.reserve(set.glyphs.size());
+    for (const auto& entry : set.glyphs) {
+        const GlyphBitmap& glyph = entry.second;
+        records.push_back(FontAtlasCacheGlyph{glyph.code, glyph.size.x, glyph.size.y, glyph.bearing.x,
+                                              glyph.bearing.y, glyph.atlasPos.x, glyph.atlasPos.y,
+                                              static_cast<int32_t>(glyph.advance)});
+    }
+
+    const std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to write font atlas cache: " << cachePath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FontAtlasCacheGlyph));
+        out.write(reinterpret_cast<const char*>(skyline.data()), skyline.size() * sizeof(SkylinePacker::Segment));
+        out.write(reinterpret_cast<const char*>(image.pixels.data()), image.pixels.size());
+        if (!out) {
+            std::cerr << "Failed to write font atlas cache: " << cachePath << "\n";
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(cachePath.c_str());  // rename does not replace existing files on Windows
+    if (std::rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to write font atlas cache: " << cachePath << "\n";
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
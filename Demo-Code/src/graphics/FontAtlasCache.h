@@ -0,0 +1,77 @@
+#ifndef FONTATLASCACHE_H
+#define FONTATLASCACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "FontCache.h"
+
+/**
+ * @brief Header of a baked font atlas cache file.
+ *
+ * The header is followed by FontAtlasCacheGlyph glyphs[glyphCount], SkylinePacker::Segment
+ * skyline[segmentCount] and the width * height atlas pixels, rows top to bottom.
+ */
+struct FontAtlasCacheHeader {
+    char magic[4];        ///< Always "RTFA".
+    uint32_t version;     ///< FONT_ATLAS_CACHE_VERSION at bake time.
+    uint64_t sourceHash;  ///< FNV-1a hash over the font file bytes.
+    uint32_t format;      ///< FONT_ATLAS_FORMAT_SDF8.
+    int32_t pixelHeight;  ///< Render height of the glyphs.
+    int32_t spread;       ///< Distance field spread in atlas pixels.
+    int32_t width;        ///< Atlas width.
+    int32_t height;       ///< Atlas height.
+    uint32_t glyphCount;  ///< Number of glyph records.
+    uint32_t segmentCount;  ///< Number of skyline segments of the atlas packer.
+    uint32_t reserved;      ///< Zero, keeps the 64 bit fields aligned.
+    uint64_t glyphArea;     ///< Pixels covered by glyphs.
+    uint64_t usedArea;      ///< Area reserved by the atlas packer, padding included.
+};
+
+/**
+ * @brief Glyph record of a baked font atlas cache file.
+ */
+struct FontAtlasCacheGlyph {
+    uint32_t code;
+    int32_t width, height;
+    int32_t bearingX, bearingY;
+    int32_t atlasX, atlasY;
+    int32_t advance;  ///< 26.6 fixed point.
+};
+
+constexpr uint32_t FONT_ATLAS_CACHE_VERSION = 1;
+
+/**
+ * @brief Atlas format id: one byte signed distance field per pixel, as produced by makeDistanceField().
+ */
+constexpr uint32_t FONT_ATLAS_FORMAT_SDF8 = 1;
+
+/**
+ * @brief Cache file of a font at one render height: "<fontPath>.<sdfPixelHeight>.atlas".
+ */
+std::string fontAtlasCachePath(const std::string& fontPath, int sdfPixelHeight);
+
+/**
+ * @brief Load a glyph set from its baked cache file with a single mapping of the file.
+ *
+ * Returns nothing if the file is missing, has another version or format, was baked from a different font
+ * file or with another spread, or does not match the atlas layout of a GlyphSet of that height.
+ *
+ * @param fontPath Path to the font file the set belongs to.
+ * @param sourceHash Hash of the font file bytes, see FontAtlasCacheHeader::sourceHash.
+ * @param sdfPixelHeight Render height.
+ * @return The set (not dirty), or nullptr.
+ */
+std::shared_ptr<GlyphSet> loadFontAtlasCache(const std::string& fontPath, uint64_t sourceHash, int sdfPixelHeight);
+
+/**
+ * @brief Write the baked cache file of a glyph set.
+ * @param fontPath Path to the font file the set belongs to.
+ * @param sourceHash Hash of the font file bytes.
+ * @param set Glyph set to save.
+ * @return True on success, false otherwise.
+ */
+bool writeFontAtlasCache(const std::string& fontPath, uint64_t sourceHash, const GlyphSet& set);
+
+#endif  // FONTATLASCACHE_H
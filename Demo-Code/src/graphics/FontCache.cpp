@@ -0,0 +1,260 @@
+#include "FontCache.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "FontAtlasCache.h"
+#include "core/Hash.h"
+#include "core/MappedFile.h"
+
+/**
+ * @brief Constructor. Creates an empty set whose atlas is sized for the render height.
+ * The atlas is 16 render heights wide and starts 4 tall, enough for about half of ASCII.
+ * @param sdfPixelHeight Render height.
+ */
+GlyphSet::GlyphSet(int sdfPixelHeight)
+    : pixelHeight(sdfPixelHeight),
+      atlas(std::min(16 * sdfPixelHeight, GLYPH_ATLAS_MAX_SIZE), std::min(4 * sdfPixelHeight, GLYPH_ATLAS_MAX_SIZE),
+            GLYPH_ATLAS_MAX_SIZE) {}
+
+/**
+ * @brief Places a rasterized glyph in the atlas and keeps its metrics; the pixels are kept by the atlas only.
+ * Glyphs without pixels (spaces, codes FreeType could not render) are only recorded.
+ * @param glyph Glyph from FontCache::rasterize(); its atlasPos is filled in.
+ * @return False if the atlas is full; the glyph is not recorded then.
+ */
+bool GlyphSet::add(GlyphBitmap& glyph) {
+    if (!atlas.insert(glyph)) return false;
+    glyphs[glyph.code] = GlyphBitmap{glyph.code, glyph.size, glyph.bearing, glyph.advance, {}, glyph.atlasPos};
+    dirty = true;
+    return true;
+}
+
+/**
+ * @brief Removes all glyphs, e.g. to make room in a full atlas.
+ */
+void GlyphSet::clear() {
+    atlas.clear();
+    glyphs.clear();
+    dirty = true;
+}
+
+/**
+ * @brief Code points held by the set.
+ */
+std::vector<uint32_t> GlyphSet::codes() const {
+    std::vector<uint32_t> result;
+    result.reserve(glyphs.size());
+    for (const auto& glyph : glyphs) result.push_back(glyph.first);
+    return result;
+}
+
+/**
+ * @brief Constructor. No font is open until open() is called.
+ * @param budgetBytes Memory the cached glyph sets may use before the least recently used ones are dropped.
+ */
+FontCache::FontCache(size_t budgetBytes) : budget(budgetBytes) {}
+
+/**
+ * @brief Destructor. Stops the rasterization workers, saves changed sets and closes the faces.
+ */
+FontCache::~FontCache() { close(); }
+
+/**
+ * @brief Opens a font file and drops the sets of the previous one. Opening the open file again is a no-op.
+ * Only the file hash is computed here; FreeType loads the face the first time a glyph has to be rasterized,
+ * so sets baked on disk are used without it.
+ * @param fontPath Path to the font file (e.g., .ttf).
+ * @return False if the file could not be read; the cache is closed then.
+ */
+bool FontCache::open(const std::string& fontPath) {
+    if (isOpen() && fontPath == path) return true;
+    close();
+
+    MappedFile file;
+    if (!file.open(fontPath)) {
+        std::cerr << "Failed to load font: " << fontPath << "\n";
+        return false;
+    }
+    sourceHash = fnv1a(file.data(), file.size());
+    path = fontPath;
+    rasterizer.open(fontPath);
+    return true;
+}
+
+/**
+ * @brief Stops the rasterization workers, saves changed sets to disk, drops all sets and closes the faces.
+ * Sets still being filled by request() are discarded.
+ */
+void FontCache::close() {
+    rasterizer.close();
+    pending.clear();
+    prefetched.clear();
+    for (auto& entry : sets) save(*entry.second.set);
+    sets.clear();
+    lru.clear();
+    path.clear();
+}
+
+/**
+ * @brief Returns the glyph set for a render height: a cached one, the one baked on disk, or a new empty one.
+ * A request() still running for the same height is waited for instead.
+ * @param sdfPixelHeight Render height, see fontSdfPixelHeight().
+ * @return The set, or nullptr if no font is open.
+ */
+std::shared_ptr<GlyphSet> FontCache::get(int sdfPixelHeight) {
+    if (auto set = find(sdfPixelHeight)) return set;
+    if (!isOpen()) return nullptr;
+
+    auto it = pending.find(sdfPixelHeight);
+    if (it != pending.end()) {
+        std::vector<RasterizedGlyph> finished;
+        while (it->second.remaining > 0 && rasterizer.wait(finished) > 0) {
+            route(finished);
+            finished.clear();
+        }
+        std::shared_ptr<GlyphSet> set = std::move(it->second.set);
+        pending.erase(it);
+        return insert(std::move(set));
+    }
+    if (auto set = loadFontAtlasCache(path, sourceHash, sdfPixelHeight)) return insert(std::move(set));
+    return insert(std::make_shared<GlyphSet>(sdfPixelHeight));
+}
+
+/**
+ * @brief Returns the glyph set for a render height if it is cached or baked on disk. Otherwise starts filling
+ * a new set with the given code points on the worker threads (once) and returns nullptr. Call again later,
+ * e.g. once per frame, to pick it up.
+ * @param sdfPixelHeight Render height, see fontSdfPixelHeight().
+ * @param codes Code points to rasterize up front, typically those of the set currently in use.
+ * @return The set, or nullptr while it is not available.
+ */
+std::shared_ptr<GlyphSet> FontCache::request(int sdfPixelHeight, const std::vector<uint32_t>& codes) {
+    if (auto set = find(sdfPixelHeight)) return set;
+    if (!isOpen()) return nullptr;
+
+    auto it = pending.find(sdfPixelHeight);
+    if (it == pending.end()) {
+        // a set baked on disk is a single read, not worth the workers
+        if (auto set = loadFontAtlasCache(path, sourceHash, sdfPixelHeight)) return insert(std::move(set));
+
+        it = pending.emplace(sdfPixelHeight, Filling{std::make_shared<GlyphSet>(sdfPixelHeight), codes.size()}).first;
+        rasterizer.submit(sdfPixelHeight, codes, REQUEST_JOB);
+    }
+
+    std::vector<RasterizedGlyph> finished;
+    rasterizer.poll(finished);
+    route(finished);
+    if (it->second.remaining > 0) return nullptr;
+
+    std::shared_ptr<GlyphSet> set = std::move(it->second.set);
+    pending.erase(it);
+    return insert(std::move(set));
+}
+
+/**
+ * @brief Has glyphs rasterized on the worker threads ahead of use; collect() hands them out.
+ * @param sdfPixelHeight Render height.
+ * @param codes Code points, typically those missing from the set in use.
+ */
+void FontCache::prefetch(int sdfPixelHeight, const std::vector<uint32_t>& codes) {
+    if (isOpen()) rasterizer.submit(sdfPixelHeight, codes, PREFETCH_JOB);
+}
+
+/**
+ * @brief Takes the prefetched glyphs finished so far for a render height, with their pixels, to be placed
+ * in the set and uploaded by the caller. Glyphs finished for other heights are dropped; they were meant
+ * for a set that is no longer in use.
+ * @param sdfPixelHeight Render height.
+ * @return Finished glyphs, possibly none.
+ */
+std::vector<RasterizedGlyph> FontCache::collect(int sdfPixelHeight) {
+    std::vector<RasterizedGlyph> finished;
+    rasterizer.poll(finished);
+    route(finished);
+
+    std::vector<RasterizedGlyph> glyphs;
+    auto it = prefetched.find(sdfPixelHeight);
+    if (it != prefetched.end()) glyphs = std::move(it->second);
+    prefetched.clear();
+    return glyphs;
+}
+
+/**
+ * @brief Rasterizes one glyph as a signed distance field right away, on the calling thread.
+ * @param sdfPixelHeight Render height.
+ * @param code Unicode code point.
+ * @param glyph Receives the distance field and metrics.
+ * @return False if no font is open or FreeType could not render the code.
+ */
+bool FontCache::rasterize(int sdfPixelHeight, uint32_t code, GlyphBitmap& glyph) {
+    return rasterizer.rasterize(sdfPixelHeight, code, glyph);
+}
+
+/**
+ * @brief Memory of all cached sets; sets grow as glyphs are added.
+ */
+size_t FontCache::getMemoryUsed() const {
+    size_t bytes = 0;
+    for (const auto& entry : sets) bytes += entry.second.set->memoryBytes();
+    return bytes;
+}
+
+/**
+ * @brief Adds a set as the most recently used one and evicts old sets beyond the budget, saving them to
+ * disk if they changed. The new set itself is never evicted, even if it alone exceeds the budget.
+ * @param set New set.
+ * @return The set.
+ */
+std::shared_ptr<GlyphSet> FontCache::insert(std::shared_ptr<GlyphSet> set) {
+    lru.push_front(set->pixelHeight);
+    sets[set->pixelHeight] = Entry{set, lru.begin()};
+
+    while (lru.size() > 1 && getMemoryUsed() > budget) {
+        auto evicted = sets.find(lru.back());
+        save(*evicted->second.set);
+        sets.erase(evicted);
+        lru.pop_back();
+    }
+    return set;
+}
+
+/**
+ * @brief Looks up a cached set and marks it most recently used.
+ * @param sdfPixelHeight Render height.
+ * @return The set, or nullptr if it is not cached.
+ */
+std::shared_ptr<GlyphSet> FontCache::find(int sdfPixelHeight) {
+    auto it = sets.find(sdfPixelHeight);
+    if (it == sets.end()) return nullptr;
+    lru.splice(lru.begin(), lru, it->second.lruPos);
+    return it->second.set;
+}
+
+/**
+ * @brief Sorts finished glyphs: those of request() go into the atlas of the set being filled, those of
+ * prefetch() are kept for collect(). Only request() glyphs count towards filling a set, even if glyphs
+ * were prefetched for the same height.
+ * @param finished Glyphs from the rasterizer; moved from.
+ */
+void FontCache::route(std::vector<RasterizedGlyph>& finished) {
+    for (RasterizedGlyph& result : finished) {
+        if (result.tag == PREFETCH_JOB) {
+            prefetched[result.pixelHeight].push_back(std::move(result));
+            continue;
+        }
+        auto it = pending.find(result.pixelHeight);
+        if (it == pending.end()) continue;  // set discarded meanwhile
+        if (it->second.remaining > 0) --it->second.remaining;
+        it->second.set->add(result.glyph);  // once full, the rest comes on demand
+    }
+}
+
+/**
+ * @brief Writes a set to its cache file if it changed since it was loaded or last saved.
+ * @param set Glyph set.
+ */
+void FontCache::save(GlyphSet& set) {
+    if (!set.dirty || set.glyphs.empty()) return;
+    if (writeFontAtlasCache(path, sourceHash, set)) set.dirty = false;
+}
@@ -0,0 +1,108 @@
+#ifndef FONTCACHE_H
+#define FONTCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GlyphAtlas.h"
+#include "GlyphRasterizer.h"
+
+/**
+ * @brief The glyphs of one font rendered at one size, in an atlas that fills up as text needs them.
+ */
+struct GlyphSet {
+    int pixelHeight;                                   ///< Render height, see fontSdfPixelHeight().
+    DynamicGlyphAtlas atlas;                           ///< Packed distance fields.
+    std::unordered_map<uint32_t, GlyphBitmap> glyphs;  ///< Metrics and atlas positions by code point, no pixels.
+    bool dirty = false;                                ///< Changed since it was loaded from or saved to disk.
+
+    explicit GlyphSet(int sdfPixelHeight);
+
+    bool add(GlyphBitmap& glyph);
+    void clear();
+    std::vector<uint32_t> codes() const;
+
+    /**
+     * @brief CPU memory held by the set, counted against the FontCache budget.
+     */
+    size_t memoryBytes() const {
+        return atlas.getImage().pixels.size() + glyphs.size() * (sizeof(uint32_t) + sizeof(GlyphBitmap));
+    }
+};
+
+/**
+ * @brief Keeps a font open and caches its glyph sets by render height.
+ *
+ * A set starts empty; rasterize() renders single glyphs into it on demand, so nothing is rendered that
+ * is never drawn, and prefetch() has glyphs that will be needed soon rendered by the worker threads of a
+ * GlyphRasterizer, to be picked up with collect(). When the render height changes, request() fills a new
+ * set with the code points the old one held on the workers and returns nothing until a later call finds
+ * it finished. Either way switching back to a known height is a hash lookup. Sets are dropped least recently used first once
+ * their memory exceeds the budget; sets still referenced elsewhere (e.g. the one Font draws from) stay
+ * alive until released.
+ * Sets that changed are baked to a cache file next to the font (see FontAtlasCache.h) when they are
+ * dropped or the cache is closed, and loaded from it with one read on the next start. FreeType is only
+ * loaded once a glyph is missing from them.
+ * All methods are called from one thread; only the rasterization itself runs on workers, each with a
+ * face of its own.
+ *
+ * Implemented in FontCache.cpp.
+ */
+class FontCache {
+   public:
+    static constexpr size_t DEFAULT_BUDGET = 8 << 20;  ///< Bytes of cached glyph sets.
+
+    explicit FontCache(size_t budgetBytes = DEFAULT_BUDGET);
+    ~FontCache();
+
+    FontCache(const FontCache&) = delete;
+    FontCache& operator=(const FontCache&) = delete;
+
+    bool open(const std::string& fontPath);
+    void close();
+
+    std::shared_ptr<GlyphSet> get(int sdfPixelHeight);
+    std::shared_ptr<GlyphSet> request(int sdfPixelHeight, const std::vector<uint32_t>& codes);
+    void prefetch(int sdfPixelHeight, const std::vector<uint32_t>& codes);
+    std::vector<RasterizedGlyph> collect(int sdfPixelHeight);
+    bool rasterize(int sdfPixelHeight, uint32_t code, GlyphBitmap& glyph);
+
+    bool isOpen() const { return !path.empty(); }
+    const std::string& getPath() const { return path; }
+    size_t getMemoryUsed() const;
+    size_t getSetCount() const { return sets.size(); }
+
+   private:
+    struct Entry {
+        std::shared_ptr<GlyphSet> set;
+        std::list<int>::iterator lruPos;  // Position in lru.
+    };
+
+    enum JobTag : uint32_t { REQUEST_JOB, PREFETCH_JOB };  // GlyphRasterizer tags of request() and prefetch().
+
+    struct Filling {
+        std::shared_ptr<GlyphSet> set;
+        size_t remaining;  // request() glyphs still on the workers.
+    };
+
+    GlyphRasterizer rasterizer;
+    std::string path;
+    uint64_t sourceHash = 0;  // Hash of the font file, keys the cache files.
+
+    std::unordered_map<int, Entry> sets;  // Sets by render height.
+    std::list<int> lru;                   // Render heights, most recently used first.
+    std::unordered_map<int, Filling> pending;  // Sets being filled by request().
+    std::unordered_map<int, std::vector<RasterizedGlyph>> prefetched;  // Finished prefetch() glyphs.
+    size_t budget;
+
+    std::shared_ptr<GlyphSet> insert(std::shared_ptr<GlyphSet> set);
+    std::shared_ptr<GlyphSet> find(int sdfPixelHeight);
+    void route(std::vector<RasterizedGlyph>& finished);
+    void save(GlyphSet& set);
+};
+
+#endif  // FONTCACHE_H
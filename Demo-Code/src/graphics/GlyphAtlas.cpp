@@ -0,0 +1,301 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief One-dimensional squared Euclidean distance transform (Felzenszwalb and Huttenlocher).
+ * @param f Input: 0 at feature pixels, a large value elsewhere. Output: squared distance to the nearest feature.
+ * @param n Number of samples.
+ * @param stride Distance between consecutive samples in f.
+ * @param v Scratch, n entries.
+ * @param z Scratch, n + 1 entries.
+ * @param d Scratch, n entries.
+ */
+void distanceTransform1D(float* f, int n, int stride, std::vector<int>& v, std::vector<float>& z,
+                         std::vector<float>& d) {
+    const float inf = 1e20f;
+    int k = 0;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    for (int q = 1; q < n; ++q) {
+        // drop parabolas of the lower envelope that the parabola rooted at q hides
+        float s;
+        for (;;) {
+            int p = v[k];
+            s = ((f[q * stride] + float(q) * q) - (f[p * stride] + float(p) * p)) / (2.0f * (q - p));
+            if (s > z[k]) break;
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        float dq = float(q - v[k]);
+        d[q] = dq * dq + f[v[k] * stride];
+    }
+    for (int q = 0; q < n; ++q) f[q * stride] = d[q];
+}
+
+/**
+ * @brief Two-dimensional squared distance transform, in place: columns first, then rows.
+ */
+void distanceTransform2D(std::vector<float>& grid, int width, int height) {
+    int n = std::max(width, height);
+    std::vector<int> v(n);
+    std::vector<float> z(n + 1), d(n);
+    for (int x = 0; x < width; ++x) distanceTransform1D(&grid[x], height, width, v, z, d);
+    for (int y = 0; y < height; ++y) distanceTransform1D(&grid[size_t(y) * width], width, 1, v, z, d);
+}
+
+}  // namespace
+
+/**
+ * @brief Distance field render height for text drawn at the given pixel height.
+ * @param pixelHeight Pixel height text is drawn at.
+ * @return Render height of the atlas to draw from.
+ */
+int fontSdfPixelHeight(int pixelHeight) {
+    int height = FONT_SDF_PIXEL_HEIGHT;
+    while (height * 2 < pixelHeight && height < FONT_SDF_MAX_PIXEL_HEIGHT) height *= 2;
+    return height;
+}
+
+/**
+ * @brief Signed distance field spread for a render height.
+ * @param sdfPixelHeight Render height from fontSdfPixelHeight().
+ * @return Spread in atlas pixels.
+ */
+int fontSdfSpread(int sdfPixelHeight) {
+    return std::max(1, FONT_SDF_SPREAD * sdfPixelHeight / FONT_SDF_PIXEL_HEIGHT);
+}
+
+/**
+ * @brief Rasterize one character code with FreeType.
+ * @param face Face with the pixel size already set.
+ * @param code Unicode code point.
+ * @param glyph Receives the bitmap and metrics.
+ * @return False if FreeType could not render the code.
+ */
+bool rasterizeGlyph(FT_Face face, uint32_t code, GlyphBitmap& glyph) {
+    if (FT_Load_Char(face, code, FT_LOAD_RENDER)) {
+        std::cerr << "Failed to load glyph: " << code << "\n";
+        return false;
+    }
+    const FT_GlyphSlot slot = face->glyph;
+    glyph = GlyphBitmap();
+    glyph.code = code;
+    glyph.size = glm::ivec2(slot->bitmap.width, slot->bitmap.rows);
+    glyph.bearing = glm::ivec2(slot->bitmap_left, slot->bitmap_top);
+    glyph.advance = slot->advance.x;
+    if (slot->bitmap.buffer) {
+        // copy row by row, the FreeType pitch may include padding
+        glyph.pixels.resize(size_t(glyph.size.x) * glyph.size.y);
+        for (int row = 0; row < glyph.size.y; ++row) {
+            std::memcpy(&glyph.pixels[size_t(row) * glyph.size.x], slot->bitmap.buffer + row * slot->bitmap.pitch,
+                        glyph.size.x);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rasterize a range of character codes with FreeType.
+ * @param face Face with the pixel size already set.
+ * @param first First character code.
+ * @param last Last character code (inclusive).
+ * @param glyphs Receives one bitmap per code that FreeType could render.
+ */
+void rasterizeGlyphs(FT_Face face, unsigned int first, unsigned int last, std::vector<GlyphBitmap>& glyphs) {
+    for (unsigned int c = first; c <= last; ++c) {
+        GlyphBitmap glyph;
+        if (rasterizeGlyph(face, c, glyph)) glyphs.push_back(std::move(glyph));
+    }
+}
+
+/**
+ * @brief Turn a coverage bitmap into a signed distance field.
+ * @param glyph Glyph rasterized by rasterizeGlyphs().
+ * @param spread Distance range on each side of the outline, in pixels.
+ */
+void makeDistanceField(GlyphBitmap& glyph, int spread) {
+    if (glyph.pixels.empty()) return;
+
+    const int width = glyph.size.x + 2 * spread;
+    const int height = glyph.size.y + 2 * spread;
+    const float far = float(width * width + height * height);
+
+    // distances to the nearest inside pixel (for outside pixels) and to the nearest outside pixel
+    std::vector<float> toInside(size_t(width) * height, far), toOutside(size_t(width) * height, 0.0f);
+    for (int y = 0; y < glyph.size.y; ++y) {
+        for (int x = 0; x < glyph.size.x; ++x) {
+            if (glyph.pixels[size_t(y) * glyph.size.x + x] < 128) continue;
+            size_t i = size_t(y + spread) * width + (x + spread);
+            toInside[i] = 0.0f;
+            toOutside[i] = far;
+        }
+    }
+    distanceTransform2D(toInside, width, height);
+    distanceTransform2D(toOutside, width, height);
+
+    std::vector<unsigned char> field(size_t(width) * height);
+    for (size_t i = 0; i < field.size(); ++i) {
+        // pixel centers are half a pixel away from the outline between an inside and an outside pixel
+        float d = toOutside[i] > 0.0f ? std::sqrt(toOutside[i]) - 0.5f : 0.5f - std::sqrt(toInside[i]);
+        float value = std::clamp(0.5f + d / (2.0f * spread), 0.0f, 1.0f);
+        field[i] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+    }
+
+    glyph.pixels = std::move(field);
+    glyph.size = glm::ivec2(width, height);
+    glyph.bearing += glm::ivec2(-spread, spread);
+}
+
+/**
+ * @brief Pack glyph bitmaps into the smallest atlas the skyline packer manages and copy them in.
+ *
+ * Glyphs are inserted tallest first. The first attempt uses a square power-of-two width just above the
+ * padded glyph area; on failure the height and then the width are doubled. The final height is trimmed
+ * to the rows actually used.
+ *
+ * @param glyphs Bitmaps to pack; their atlasPos is filled in.
+ * @param atlas Receives the atlas image.
+ * @return False if the glyphs do not fit into GLYPH_ATLAS_MAX_SIZE squared.
+ */
+bool packGlyphAtlas(std::vector<GlyphBitmap>& glyphs, GlyphAtlasImage& atlas) {
+    const int pad = GLYPH_ATLAS_PADDING;
+    size_t paddedArea = 0;
+    atlas.glyphArea = 0;
+    for (const auto& glyph : glyphs) {
+        if (glyph.pixels.empty()) continue;
+        paddedArea += size_t(glyph.size.x + pad) * size_t(glyph.size.y + pad);
+        atlas.glyphArea += size_t(glyph.size.x) * size_t(glyph.size.y);
+    }
+
+    std::vector<size_t> order(glyphs.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return glyphs[a].size.y > glyphs[b].size.y; });
+
+    int width = 16;
+    while (size_t(width) * width < paddedArea) width *= 2;
+    int height = width;
+
+    SkylinePacker packer;
+    for (;;) {
+        if (width > GLYPH_ATLAS_MAX_SIZE || height > GLYPH_ATLAS_MAX_SIZE) {
+            std::cerr << "Glyph atlas exceeds " << GLYPH_ATLAS_MAX_SIZE << " pixels\n";
+            return false;
+        }
+        // the packed area starts one pixel in, so every glyph has padding on all four sides
+        packer.reset(width - pad, height - pad);
+        bool packed = true;
+        for (size_t i : order) {
+            GlyphBitmap& glyph = glyphs[i];
+            if (glyph.pixels.empty()) continue;
+            glm::ivec2 pos;
+            if (!packer.insert(glyph.size.x + pad, glyph.size.y + pad, pos)) {
+                packed = false;
+                break;
+            }
+            glyph.atlasPos = pos + glm::ivec2(pad);
+        }
+        if (packed) break;
+        if (height <= width) {
+            height *= 2;
+        } else {
+            width *= 2;
+        }
+    }
+
+    atlas.width = width;
+    atlas.height = std::max(packer.getUsedHeight() + pad, 1);
+    atlas.pixels.assign(size_t(atlas.width) * atlas.height, 0);
+    for (const auto& glyph : glyphs) {
+        for (int row = 0; row < glyph.size.y && !glyph.pixels.empty(); ++row) {
+            std::memcpy(&atlas.pixels[size_t(glyph.atlasPos.y + row) * atlas.width + glyph.atlasPos.x],
+                        &glyph.pixels[size_t(row) * glyph.size.x], glyph.size.x);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Constructor. Creates an empty atlas.
+ * @param width Atlas width, fixed.
+ * @param initialHeight Height before the first growth.
+ * @param maxHeight Largest height the atlas grows to.
+ */
+DynamicGlyphAtlas::DynamicGlyphAtlas(int width, int initialHeight, int maxHeight)
+    : packer(width - GLYPH_ATLAS_PADDING, initialHeight - GLYPH_ATLAS_PADDING), maxHeight(maxHeight) {
+    image.width = width;
+    image.height = initialHeight;
+    image.pixels.assign(size_t(width) * initialHeight, 0);
+}
+
+/**
+ * @brief Places a glyph and copies its pixels into the atlas, growing the atlas if needed.
+ * The caller can tell a growth from a changed getImage().height.
+ * @param glyph Glyph to place; its atlasPos is filled in.
+ * @return False if the glyph does not fit even at the maximum height.
+ */
+bool DynamicGlyphAtlas::insert(GlyphBitmap& glyph) {
+    const int pad = GLYPH_ATLAS_PADDING;
+    if (glyph.pixels.empty()) return true;  // e.g. the space, nothing to store
+
+    glm::ivec2 pos;
+    while (!packer.insert(glyph.size.x + pad, glyph.size.y + pad, pos)) {
+        if (image.height >= maxHeight) return false;
+        image.height = std::min(image.height * 2, maxHeight);
+        image.pixels.resize(size_t(image.width) * image.height, 0);
+        packer.growHeight(image.height - pad);
+    }
+    glyph.atlasPos = pos + glm::ivec2(pad);
+    for (int row = 0; row < glyph.size.y; ++row) {
+        std::memcpy(&image.pixels[size_t(glyph.atlasPos.y + row) * image.width + glyph.atlasPos.x],
+                    &glyph.pixels[size_t(row) * glyph.size.x], glyph.size.x);
+    }
+    image.glyphArea += size_t(glyph.size.x) * size_t(glyph.size.y);
+    return true;
+}
+
+/**
+ * @brief Removes all glyphs; the atlas keeps its current size.
+ */
+void DynamicGlyphAtlas::clear() {
+    packer.reset(image.width - GLYPH_ATLAS_PADDING, image.height - GLYPH_ATLAS_PADDING);
+    std::fill(image.pixels.begin(), image.pixels.end(), 0);
+    image.glyphArea = 0;
+}
+
+/**
+ * @brief Replaces the atlas with a saved one and continues packing where it left off.
+ * @param savedImage Atlas pixels; the width must match, the height may be anything up to the maximum.
+ * @param skyline Outline of the packer that filled the saved atlas, see getPacker().
+ * @param usedArea Area reserved by that packer.
+ * @return False if the saved state does not fit this atlas; the atlas is left unchanged then.
+ */
+bool DynamicGlyphAtlas::restore(GlyphAtlasImage savedImage, const std::vector<SkylinePacker::Segment>& skyline,
+                                size_t usedArea) {
+    const int pad = GLYPH_ATLAS_PADDING;
+    if (savedImage.width != image.width || savedImage.height <= pad || savedImage.height > maxHeight ||
+        savedImage.pixels.size() != size_t(savedImage.width) * savedImage.height) {
+        return false;
+    }
+    SkylinePacker saved;
+    if (!saved.restore(savedImage.width - pad, savedImage.height - pad, skyline, usedArea)) return false;
+
+    image = std::move(savedImage);
+    packer = saved;
+    return true;
+}
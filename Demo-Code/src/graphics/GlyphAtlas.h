@@ -0,0 +1,149 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <ft2build.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+#include FT_FREETYPE_H
+
+#include "SkylinePacker.h"
+
+/**
+ * @brief A rasterized glyph waiting to be placed in an atlas.
+ */
+struct GlyphBitmap {
+    unsigned int code = 0;              ///< Character code.
+    glm::ivec2 size{0};                 ///< Bitmap size in pixels.
+    glm::ivec2 bearing{0};              ///< Offset from baseline to left/top of glyph.
+    long advance = 0;                   ///< Horizontal advance in 1/64 pixels.
+    std::vector<unsigned char> pixels;  ///< size.x * size.y coverage or distance values, rows top to bottom.
+    glm::ivec2 atlasPos{0};             ///< Top-left corner in the atlas, set by packGlyphAtlas().
+};
+
+/**
+ * @brief Single channel atlas image holding many glyphs.
+ */
+struct GlyphAtlasImage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;  ///< width * height coverage values, rows top to bottom.
+    size_t glyphArea = 0;               ///< Pixels covered by glyph bitmaps.
+
+    /**
+     * @brief Fraction of the atlas covered by glyphs.
+     */
+    float density() const { return width > 0 && height > 0 ? float(glyphArea) / float(width * height) : 0.0f; }
+};
+
+/**
+ * @brief Empty border around every glyph so linear filtering never samples a neighbour.
+ */
+constexpr int GLYPH_ATLAS_PADDING = 1;
+
+/**
+ * @brief Largest atlas edge; beyond that a pixel height simply does not fit.
+ */
+constexpr int GLYPH_ATLAS_MAX_SIZE = 4096;
+
+/**
+ * @brief Smallest pixel height signed distance field atlases are rendered at; Font scales from there.
+ */
+constexpr int FONT_SDF_PIXEL_HEIGHT = 64;
+
+/**
+ * @brief Largest distance field render height, reached by doubling FONT_SDF_PIXEL_HEIGHT.
+ */
+constexpr int FONT_SDF_MAX_PIXEL_HEIGHT = 256;
+
+/**
+ * @brief Distance in atlas pixels covered by the signed distance field on each side of the outline at
+ * FONT_SDF_PIXEL_HEIGHT; larger render heights scale it along. Enough for a smooth edge from about a
+ * quarter to twice the render height.
+ */
+constexpr int FONT_SDF_SPREAD = 8;
+
+/**
+ * @brief Distance field render height for text drawn at the given pixel height.
+ * Starts at FONT_SDF_PIXEL_HEIGHT and doubles while the text would be magnified more than twice, up to
+ * FONT_SDF_MAX_PIXEL_HEIGHT. Every window height up to 4K shares the first step.
+ * @param pixelHeight Pixel height text is drawn at.
+ * @return Render height of the atlas to draw from.
+ */
+int fontSdfPixelHeight(int pixelHeight);
+
+/**
+ * @brief Signed distance field spread for a render height, FONT_SDF_SPREAD scaled along with it.
+ * @param sdfPixelHeight Render height from fontSdfPixelHeight().
+ * @return Spread in atlas pixels.
+ */
+int fontSdfSpread(int sdfPixelHeight);
+
+/**
+ * @brief Rasterize one character code with FreeType.
+ * Codes the font has no glyph for come out as its missing glyph box.
+ * @param face Face with the pixel size already set.
+ * @param code Unicode code point.
+ * @param glyph Receives the bitmap and metrics.
+ * @return False if FreeType could not render the code.
+ */
+bool rasterizeGlyph(FT_Face face, uint32_t code, GlyphBitmap& glyph);
+
+/**
+ * @brief Rasterize a range of character codes with FreeType.
+ * @param face Face with the pixel size already set.
+ * @param first First character code.
+ * @param last Last character code (inclusive).
+ * @param glyphs Receives one bitmap per code that FreeType could render.
+ */
+void rasterizeGlyphs(FT_Face face, unsigned int first, unsigned int last, std::vector<GlyphBitmap>& glyphs);
+
+/**
+ * @brief Turn a coverage bitmap into a signed distance field.
+ *
+ * The bitmap grows by spread pixels on every side (bearing adjusted accordingly). Each pixel then holds
+ * 0.5 + d / (2 * spread), clamped to [0, 1], where d is the Euclidean distance to the outline, positive
+ * inside. The distances come from an exact linear-time distance transform, which is much faster than
+ * FreeType's outline SDF renderer for fonts with many short contour segments.
+ *
+ * @param glyph Glyph rasterized by rasterizeGlyphs().
+ * @param spread Distance range on each side of the outline, in pixels.
+ */
+void makeDistanceField(GlyphBitmap& glyph, int spread);
+
+/**
+ * @brief Pack glyph bitmaps into the smallest atlas the skyline packer manages and copy them in.
+ * @param glyphs Bitmaps to pack; their atlasPos is filled in.
+ * @param atlas Receives the atlas image.
+ * @return False if the glyphs do not fit into GLYPH_ATLAS_MAX_SIZE squared.
+ */
+bool packGlyphAtlas(std::vector<GlyphBitmap>& glyphs, GlyphAtlasImage& atlas);
+
+/**
+ * @brief Glyph atlas that is filled one glyph at a time while the program runs.
+ *
+ * The width is fixed; when a glyph does not fit, the height doubles up to the maximum, so glyphs already
+ * placed keep their pixel position. Once the maximum is full, insert() fails and the owner decides what
+ * to evict; clear() empties the atlas but keeps its size.
+ *
+ * Implemented in GlyphAtlas.cpp.
+ */
+class DynamicGlyphAtlas {
+   public:
+    DynamicGlyphAtlas(int width, int initialHeight, int maxHeight);
+
+    bool insert(GlyphBitmap& glyph);
+    void clear();
+    bool restore(GlyphAtlasImage savedImage, const std::vector<SkylinePacker::Segment>& skyline, size_t usedArea);
+
+    const GlyphAtlasImage& getImage() const { return image; }
+    const SkylinePacker& getPacker() const { return packer; }
+    int getMaxHeight() const { return maxHeight; }
+
+   private:
+    GlyphAtlasImage image;  // CPU copy of the whole atlas.
+    SkylinePacker packer;
+    int maxHeight;
+};
+
+#endif // GLYPHATLAS_H
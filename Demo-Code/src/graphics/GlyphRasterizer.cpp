@@ -0,0 +1,188 @@
+#include "GlyphRasterizer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+/**
+ * @brief Constructor. No font is open and no thread runs until open() and submit() are called.
+ * @param threads Number of worker threads, at least one.
+ */
+GlyphRasterizer::GlyphRasterizer(unsigned threads) : threadCount(std::max(1u, threads)) {}
+
+/**
+ * @brief Destructor. Joins the workers and closes the faces.
+ */
+GlyphRasterizer::~GlyphRasterizer() { close(); }
+
+/**
+ * @brief Worker count for a rasterizer: one core is left to the render loop, at most
+ * GLYPH_RASTERIZER_MAX_THREADS.
+ */
+unsigned GlyphRasterizer::defaultThreadCount() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return std::min(GLYPH_RASTERIZER_MAX_THREADS, cores > 1 ? cores - 1 : 1u);
+}
+
+/**
+ * @brief Switches to a font file. Work queued for the previous one is discarded.
+ * Nothing is loaded here; each thread loads the face when it first needs it.
+ * @param fontPath Path to the font file (e.g., .ttf).
+ */
+void GlyphRasterizer::open(const std::string& fontPath) {
+    close();
+    path = fontPath;
+}
+
+/**
+ * @brief Stops and joins the workers, discards queued jobs and results and closes the caller face.
+ */
+void GlyphRasterizer::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = false;
+    results.clear();
+    outstanding = 0;
+    callerFace.close();
+    path.clear();
+}
+
+/**
+ * @brief Queues glyphs for the workers, starting them on first use.
+ * @param sdfPixelHeight Render height.
+ * @param codes Code points; each one comes back as a RasterizedGlyph.
+ * @param tag Copied to the RasterizedGlyph of each code.
+ */
+void GlyphRasterizer::submit(int sdfPixelHeight, const std::vector<uint32_t>& codes, uint32_t tag) {
+    if (codes.empty() || path.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (uint32_t code : codes) jobs.push_back(Job{sdfPixelHeight, code, tag});
+    }
+    outstanding += codes.size();
+
+    while (workers.size() < threadCount) workers.emplace_back(&GlyphRasterizer::work, this);
+    jobReady.notify_all();
+}
+
+/**
+ * @brief Moves the glyphs finished so far to out without blocking.
+ * @param out Receives the glyphs, appended.
+ * @return Number of glyphs appended.
+ */
+size_t GlyphRasterizer::poll(std::vector<RasterizedGlyph>& out) {
+    if (outstanding == 0) return 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = results.size();
+    std::move(results.begin(), results.end(), std::back_inserter(out));
+    results.clear();
+    outstanding -= count;
+    return count;
+}
+
+/**
+ * @brief Like poll(), but blocks until at least one glyph is finished if any are outstanding.
+ * @param out Receives the glyphs, appended.
+ * @return Number of glyphs appended; zero only if nothing is outstanding.
+ */
+size_t GlyphRasterizer::wait(std::vector<RasterizedGlyph>& out) {
+    if (outstanding == 0) return 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        resultReady.wait(lock, [this] { return !results.empty(); });
+    }
+    return poll(out);
+}
+
+/**
+ * @brief Rasterizes one glyph right away on the calling thread with its own face, for text that needs it
+ * in this frame.
+ * @param sdfPixelHeight Render height.
+ * @param code Unicode code point.
+ * @param glyph Receives the distance field and metrics.
+ * @return False if no font is open or FreeType could not render the code.
+ */
+bool GlyphRasterizer::rasterize(int sdfPixelHeight, uint32_t code, GlyphBitmap& glyph) {
+    return callerFace.render(path, sdfPixelHeight, code, glyph);
+}
+
+/**
+ * @brief Worker loop: takes jobs until close() with a face of its own.
+ */
+void GlyphRasterizer::work() {
+    Face face;
+    std::unique_lock<std::mutex> lock(mutex);
+    const std::string fontPath = path;
+    while (true) {
+        jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping) break;
+        Job job = jobs.front();
+        jobs.pop_front();
+        lock.unlock();
+
+        RasterizedGlyph result{job.pixelHeight, GlyphBitmap{}, false, job.tag};
+        result.rendered = face.render(fontPath, job.pixelHeight, job.code, result.glyph);
+        if (!result.rendered) {
+            result.glyph = GlyphBitmap{};
+            result.glyph.code = job.code;
+        }
+
+        lock.lock();
+        results.push_back(std::move(result));
+        resultReady.notify_one();
+    }
+    lock.unlock();
+    face.close();
+}
+
+/**
+ * @brief Renders one glyph as a signed distance field, loading the face first if needed.
+ * @param fontPath Font file.
+ * @param sdfPixelHeight Render height.
+ * @param code Unicode code point.
+ * @param glyph Receives the distance field and metrics.
+ * @return False if the font or the code could not be loaded.
+ */
+bool GlyphRasterizer::Face::render(const std::string& fontPath, int sdfPixelHeight, uint32_t code,
+                                   GlyphBitmap& glyph) {
+    if (!face) {
+        if (failed || fontPath.empty()) return false;
+        if (FT_Init_FreeType(&library)) {
+            std::cerr << "Failed to init FreeType library\n";
+            library = nullptr;
+            failed = true;
+            return false;
+        }
+        if (FT_New_Face(library, fontPath.c_str(), 0, &face)) {
+            std::cerr << "Failed to load font: " << fontPath << "\n";
+            FT_Done_FreeType(library);
+            library = nullptr;
+            face = nullptr;
+            failed = true;
+            return false;
+        }
+    }
+    FT_Set_Pixel_Sizes(face, 0, sdfPixelHeight);
+    if (!rasterizeGlyph(face, code, glyph)) return false;
+    makeDistanceField(glyph, fontSdfSpread(sdfPixelHeight));
+    return true;
+}
+
+/**
+ * @brief Releases the face and its library.
+ */
+void GlyphRasterizer::Face::close() {
+    if (face) FT_Done_Face(face);
+    if (library) FT_Done_FreeType(library);
+    face = nullptr;
+    library = nullptr;
+    failed = false;
+}
@@ -0,0 +1,102 @@
+#ifndef GLYPHRASTERIZER_H
+#define GLYPHRASTERIZER_H
+
+#include <ft2build.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include FT_FREETYPE_H
+
+#include "GlyphAtlas.h"
+
+/**
+ * @brief Upper bound for the worker threads of a GlyphRasterizer.
+ */
+constexpr unsigned GLYPH_RASTERIZER_MAX_THREADS = 4;
+
+/**
+ * @brief A glyph finished by a GlyphRasterizer worker.
+ */
+struct RasterizedGlyph {
+    int pixelHeight;    ///< Render height it was requested for.
+    GlyphBitmap glyph;  ///< Distance field and metrics; only the code is set if rendered is false.
+    bool rendered;      ///< False if FreeType could not render the code.
+    uint32_t tag;       ///< Value passed to submit(), to tell apart glyphs submitted for different purposes.
+};
+
+/**
+ * @brief Rasterizes signed distance field glyphs of one font on a pool of worker threads.
+ *
+ * FreeType faces are not thread safe, so every worker loads its own library and face the first time it
+ * gets a job; the caller thread has one more for rasterize(). Jobs go into a shared queue and finished
+ * glyphs into a result queue that the owner drains with poll() or wait() on its own thread, where they
+ * are placed in an atlas and uploaded. Workers start with the first submit() and are joined by close().
+ * submit(), poll(), wait() and rasterize() are called from the owning thread only.
+ *
+ * Implemented in GlyphRasterizer.cpp.
+ */
+class GlyphRasterizer {
+   public:
+    explicit GlyphRasterizer(unsigned threads = defaultThreadCount());
+    ~GlyphRasterizer();
+
+    GlyphRasterizer(const GlyphRasterizer&) = delete;
+    GlyphRasterizer& operator=(const GlyphRasterizer&) = delete;
+
+    void open(const std::string& fontPath);
+    void close();
+
+    void submit(int sdfPixelHeight, const std::vector<uint32_t>& codes, uint32_t tag = 0);
+    size_t poll(std::vector<RasterizedGlyph>& out);
+    size_t wait(std::vector<RasterizedGlyph>& out);
+    bool rasterize(int sdfPixelHeight, uint32_t code, GlyphBitmap& glyph);
+
+    /**
+     * @brief Number of submitted glyphs not handed out by poll() or wait() yet.
+     */
+    size_t getOutstanding() const { return outstanding; }
+    unsigned getThreadCount() const { return threadCount; }
+
+    static unsigned defaultThreadCount();
+
+   private:
+    /**
+     * @brief A FreeType library and face owned by one thread, loaded on first use.
+     */
+    struct Face {
+        FT_Library library = nullptr;
+        FT_Face face = nullptr;
+        bool failed = false;  // FreeType could not load the font, do not retry.
+
+        bool render(const std::string& fontPath, int sdfPixelHeight, uint32_t code, GlyphBitmap& glyph);
+        void close();
+    };
+
+    struct Job {
+        int pixelHeight;
+        uint32_t code;
+        uint32_t tag;
+    };
+
+    std::string path;
+    unsigned threadCount;
+    Face callerFace;  // Face of the owning thread, for rasterize().
+    std::vector<std::thread> workers;
+    size_t outstanding = 0;  // Submitted jobs not handed out yet; owning thread only.
+
+    std::mutex mutex;  // Guards everything below.
+    std::condition_variable jobReady;
+    std::condition_variable resultReady;
+    std::deque<Job> jobs;
+    std::vector<RasterizedGlyph> results;
+    bool stopping = false;
+
+    void work();
+};
+
+#endif  // GLYPHRASTERIZER_H
@@ -0,0 +1,51 @@
+#include "GlyphTable.h"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor. Creates an empty table.
+ */
+GlyphTable::GlyphTable() { clear(); }
+
+/**
+ * @brief Removes all glyphs.
+ */
+void GlyphTable::clear() {
+    characters.clear();
+    std::fill(std::begin(denseSlots), std::end(denseSlots), -1);
+    sparseSlots.clear();
+}
+
+/**
+ * @brief Adds a glyph placed in an atlas, converting its advance from 26.6 fixed point to pixels.
+ * @param glyph Glyph with its atlasPos filled in.
+ * @return The stored glyph.
+ */
+const Character* GlyphTable::insert(const GlyphBitmap& glyph) {
+    Character character = {glm::vec2(glyph.atlasPos), glm::vec2(glyph.atlasPos + glyph.size), glyph.size,
+                           glyph.bearing, float(glyph.advance) / 64.0f};
+    return insert(glyph.code, character);
+}
+
+/**
+ * @brief Adds a glyph or replaces the one stored for the same code point.
+ * Pointers returned by find() are invalidated.
+ * @param code Code point.
+ * @param character Glyph metrics and texture coordinates.
+ * @return The stored glyph.
+ */
+const Character* GlyphTable::insert(uint32_t code, const Character& character) {
+    int32_t* slot = nullptr;
+    if (code < DENSE_CODES) {
+        slot = &denseSlots[code];
+    } else {
+        slot = &sparseSlots.emplace(code, -1).first->second;
+    }
+    if (*slot < 0) {
+        *slot = static_cast<int32_t>(characters.size());
+        characters.push_back(character);
+    } else {
+        characters[*slot] = character;
+    }
+    return &characters[*slot];
+}
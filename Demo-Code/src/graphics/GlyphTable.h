@@ -0,0 +1,64 @@
+#ifndef GLYPHTABLE_H
+#define GLYPHTABLE_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "GlyphAtlas.h"
+
+/**
+ * @brief Stores all relevant information for a single character glyph.
+ */
+struct Character {
+    glm::vec2 uvMin;     ///< Top-left corner of the glyph in the atlas, in atlas pixels.
+    glm::vec2 uvMax;     ///< Bottom-right corner of the glyph in the atlas, in atlas pixels.
+    glm::ivec2 size;     ///< Size of the glyph in pixels.
+    glm::ivec2 bearing;  ///< Offset from baseline to left/top of glyph.
+    float advance;       ///< Offset to advance to next glyph, in pixels.
+};
+
+/**
+ * @brief Glyph lookup by code point for the text hot path.
+ *
+ * Characters are stored contiguously. Code points below DENSE_CODES map to their slot through a flat
+ * array, so the common case is two array reads; higher code points go through a hash map.
+ * Texture coordinates are kept in atlas pixels (the shader normalizes them), so they stay valid when the
+ * atlas grows.
+ *
+ * Implemented in GlyphTable.cpp.
+ */
+class GlyphTable {
+   public:
+    static constexpr uint32_t DENSE_CODES = 256;
+
+    GlyphTable();
+
+    void clear();
+    const Character* insert(const GlyphBitmap& glyph);
+    const Character* insert(uint32_t code, const Character& character);
+
+    /**
+     * @brief Looks up a glyph.
+     * @param code Code point.
+     * @return The glyph, or nullptr if the font has none for the code.
+     */
+    const Character* find(uint32_t code) const {
+        if (code < DENSE_CODES) {
+            int32_t slot = denseSlots[code];
+            return slot >= 0 ? &characters[slot] : nullptr;
+        }
+        auto it = sparseSlots.find(code);
+        return it != sparseSlots.end() ? &characters[it->second] : nullptr;
+    }
+
+    size_t size() const { return characters.size(); }
+
+   private:
+    std::vector<Character> characters;                  // All glyphs, in insertion order.
+    int32_t denseSlots[DENSE_CODES];                    // Slot of each low code point, -1 if missing.
+    std::unordered_map<uint32_t, int32_t> sparseSlots;  // Slot of each code point >= DENSE_CODES.
+};
+
+#endif  // GLYPHTABLE_H
@@ -0,0 +1,149 @@
+#include "LineBatch.h"
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "ShaderManager.h"
+
+/**
+ * @brief Constructor. No GL objects are created until initialize() is called.
+ */
+LineBatch::LineBatch() : vao(0), vbo(0), shaderProgram(0), bufferCapacity(0), lineWidth(1.0f) {}
+
+/**
+ * @brief Destructor. Releases the vertex array, buffer and shader program.
+ */
+LineBatch::~LineBatch() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (shaderProgram) glDeleteProgram(shaderProgram);
+}
+
+/**
+ * @brief Loads the shader and creates the vertex array and streaming buffer.
+ * @return True on success, false if the shader could not be loaded.
+ */
+bool LineBatch::initialize() {
+    shaderProgram = ShaderManager::loadShader("shaders/line_batch.vert", "shaders/line_batch.frag");
+    if (!shaderProgram) {
+        std::cerr << "ERROR::LINEBATCH:: Failed to load shaders!" << std::endl;
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, pos));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glBindVertexArray(0);
+    return true;
+}
+
+/**
+ * @brief Appends one vertex and extends the last command or starts a new one.
+ * @param mode Primitive mode of the vertex.
+ * @param size Line width or point size.
+ * @param pos Position in the space of the projection.
+ * @param color Vertex color.
+ * @param projection Projection matrix applied on the CPU.
+ */
+void LineBatch::push(GLenum mode, float size, glm::vec2 pos, const glm::vec4& color, const glm::mat4& projection) {
+    glm::vec4 clip = projection * glm::vec4(pos.x, pos.y, 0.0f, 1.0f);
+    vertices.push_back({glm::vec2(clip.x, clip.y) / clip.w, color});
+
+    if (commands.empty() || commands.back().mode != mode || commands.back().size != size) {
+        commands.push_back({mode, size, static_cast<GLint>(vertices.size() - 1), 0});
+    }
+    commands.back().count++;
+}
+
+/**
+ * @brief Adds a line segment.
+ * @param a Start point.
+ * @param b End point.
+ * @param color Line color.
+ * @param projection Projection matrix.
+ */
+void LineBatch::addLine(glm::vec2 a, glm::vec2 b, const glm::vec4& color, const glm::mat4& projection) {
+    push(GL_LINES, lineWidth, a, color, projection);
+    push(GL_LINES, lineWidth, b, color, projection);
+}
+
+/**
+ * @brief Adds a closed circle outline as line segments.
+ * @param center Circle center.
+ * @param radius Circle radius.
+ * @param color Circle color.
+ * @param projection Projection matrix.
+ * @param segments Number of segments.
+ */
+void LineBatch::addCircle(glm::vec2 center, float radius, const glm::vec4& color, const glm::mat4& projection,
+                          int segments) {
+    const float step = 2.0f * 3.14159265358979323846f / segments;
+    glm::vec2 prev = center + glm::vec2(radius, 0.0f);
+    for (int i = 1; i <= segments; ++i) {
+        glm::vec2 next = center + glm::vec2(std::cos(i * step), std::sin(i * step)) * radius;
+        addLine(prev, next, color, projection);
+        prev = next;
+    }
+}
+
+/**
+ * @brief Adds a cross of two axis-aligned lines.
+ * @param center Cross center.
+ * @param len Half length of the arms.
+ * @param color Cross color.
+ * @param projection Projection matrix.
+ */
+void LineBatch::addCross(glm::vec2 center, float len, const glm::vec4& color, const glm::mat4& projection) {
+    addLine(center - glm::vec2(len, 0.0f), center + glm::vec2(len, 0.0f), color, projection);
+    addLine(center - glm::vec2(0.0f, len), center + glm::vec2(0.0f, len), color, projection);
+}
+
+/**
+ * @brief Adds a point.
+ * @param pos Point position.
+ * @param size Point size in pixels.
+ * @param color Point color.
+ * @param projection Projection matrix.
+ */
+void LineBatch::addPoint(glm::vec2 pos, float size, const glm::vec4& color, const glm::mat4& projection) {
+    push(GL_POINTS, size, pos, color, projection);
+}
+
+/**
+ * @brief Uploads all collected vertices with one buffer update and draws them.
+ * The buffer only grows; it is orphaned every frame so the driver does not stall on the previous draw.
+ * Restores the line width to 1.
+ * @return Number of draw calls issued.
+ */
+int LineBatch::flush() {
+    if (commands.empty()) return 0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (vertices.size() > bufferCapacity) bufferCapacity = vertices.size() * 2;
+    glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+
+    glUseProgram(shaderProgram);
+    glBindVertexArray(vao);
+    for (const auto& cmd : commands) {
+        if (cmd.mode == GL_POINTS) {
+            glPointSize(cmd.size);
+        } else {
+            glLineWidth(cmd.size);
+        }
+        glDrawArrays(cmd.mode, cmd.first, cmd.count);
+    }
+    glBindVertexArray(0);
+    glLineWidth(1.0f);
+
+    int drawCalls = static_cast<int>(commands.size());
+    vertices.clear();
+    commands.clear();
+    return drawCalls;
+}
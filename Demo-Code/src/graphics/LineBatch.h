@@ -0,0 +1,60 @@
+#ifndef LINEBATCH_H
+#define LINEBATCH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/**
+ * @brief Collects the lines, loops and points of a frame and draws them with as few calls as possible.
+ * Vertices are transformed to clip space on the CPU when added and carry their own color, so primitives
+ * with different projections and colors share one buffer. flush() uploads the buffer once and issues one
+ * draw per run of consecutive primitives with the same mode and line width (or point size), keeping the
+ * order in which they were added.
+ *
+ * Implemented in LineBatch.cpp.
+ */
+class LineBatch {
+public:
+    LineBatch();
+    ~LineBatch();
+
+    LineBatch(const LineBatch&) = delete;
+    LineBatch& operator=(const LineBatch&) = delete;
+
+    bool initialize();
+
+    void setLineWidth(float width) { lineWidth = width; }
+    void addLine(glm::vec2 a, glm::vec2 b, const glm::vec4& color, const glm::mat4& projection);
+    void addCircle(glm::vec2 center, float radius, const glm::vec4& color, const glm::mat4& projection,
+                   int segments = 128);
+    void addCross(glm::vec2 center, float len, const glm::vec4& color, const glm::mat4& projection);
+    void addPoint(glm::vec2 pos, float size, const glm::vec4& color, const glm::mat4& projection);
+
+    int flush();
+
+private:
+    struct Vertex {
+        glm::vec2 pos;    // Clip space position.
+        glm::vec4 color;
+    };
+
+    struct Command {
+        GLenum mode;      // GL_LINES or GL_POINTS.
+        float size;       // Line width or point size.
+        GLint first;
+        GLsizei count;
+    };
+
+    GLuint vao, vbo;
+    GLuint shaderProgram;
+    size_t bufferCapacity;          // Size of the VBO in vertices.
+    float lineWidth;                // Width recorded with the next lines.
+    std::vector<Vertex> vertices;   // Vertices of the current frame, reused across frames.
+    std::vector<Command> commands;  // Draw ranges of the current frame.
+
+    void push(GLenum mode, float size, glm::vec2 pos, const glm::vec4& color, const glm::mat4& projection);
+};
+
+#endif // LINEBATCH_H
@@ -0,0 +1,169 @@
+#include "MapMesh.h"
+
+namespace {
+
+/**
+ * @brief Append the centroid of each ring once per point of that ring.
+ * @param map Polylines of one level; its rings line up with the source rings.
+ * @param centroids Quantized centroids of the source rings.
+ * @param out Per-vertex centroids, in VBO order.
+ */
+void appendVertexCentroids(const PolylineSet& map, const std::vector<QuantizedPoint>& centroids,
+                           std::vector<QuantizedPoint>& out) {
+    for (size_t ring = 0; ring < map.ringCount(); ++ring) out.insert(out.end(), map.ringSize(ring), centroids[ring]);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor. No GL objects are created until upload() is called.
+ */
+MapMesh::MapMesh() : vao(0), vbo(0), centroidVbo(0) {}
+
+/**
+ * @brief Destructor. Releases the vertex array and buffer.
+ */
+MapMesh::~MapMesh() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (centroidVbo) glDeleteBuffers(1, &centroidVbo);
+}
+
+/**
+ * @brief Uploads a map and its simplified levels into one static VBO and builds the multi-draw ranges.
+ * Points are stored as int16 coordinates on a grid over the map's bounding box (4 bytes per vertex);
+ * the shader maps them back with the center and step from getQuantization().
+ * @param map Full resolution polylines.
+ * @param lods Simplified levels, finest first (see buildMapLods).
+ * @param ringCentroids Also upload the centroid of each vertex's ring as attribute 1. Every level uses the
+ *        centroids of the full resolution rings, so the pulse pivot does not move between levels.
+ */
+void MapMesh::upload(const PolylineSet& map, const std::vector<MapLod>& lods, bool ringCentroids) {
+    if (!vao) glGenVertexArrays(1, &vao);
+    if (!vbo) glGenBuffers(1, &vbo);
+
+    size_t totalVertices = map.pointCount();
+    for (const auto& lod : lods) totalVertices += lod.map.pointCount();
+
+    quantization = computeQuantization(map);
+    std::vector<QuantizedPoint> vertices;
+    vertices.reserve(totalVertices);
+
+    levels.clear();
+    quantizePoints(map.points(), map.pointCount(), quantization, vertices);
+    appendLevel(map, 0.0f, 0);
+    for (const auto& lod : lods) {
+        size_t baseVertex = vertices.size();
+        quantizePoints(lod.map.points(), lod.map.pointCount(), quantization, vertices);
+        appendLevel(lod.map, lod.tolerance, baseVertex);
+    }
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(QuantizedPoint), vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    // not normalized: the shader receives the raw grid coordinates as floats
+    glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(QuantizedPoint), (void*)0);
+
+    if (ringCentroids) {
+        std::vector<QuantizedPoint> quantizedCentroids;
+        quantizedCentroids.reserve(map.ringCount());
+        for (size_t ring = 0; ring < map.ringCount(); ++ring) {
+            quantizedCentroids.push_back(quantization.quantize(map.ringCentroid(ring)));
+        }
+        std::vector<QuantizedPoint> vertexCentroids;
+        vertexCentroids.reserve(totalVertices);
+        appendVertexCentroids(map, quantizedCentroids, vertexCentroids);
+        for (const auto& lod : lods) appendVertexCentroids(lod.map, quantizedCentroids, vertexCentroids);
+
+        if (!centroidVbo) glGenBuffers(1, &centroidVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, centroidVbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexCentroids.size() * sizeof(QuantizedPoint), vertexCentroids.data(),
+                     GL_STATIC_DRAW);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(QuantizedPoint), (void*)0);
+    }
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Records the multi-draw ranges and the chunk index of one level.
+ * @param map Polylines of the level.
+ * @param tolerance Simplification tolerance of the level.
+ * @param baseVertex Position of the level's first point in the VBO.
+ */
+void MapMesh::appendLevel(const PolylineSet& map, float tolerance, size_t baseVertex) {
+    Level level;
+    level.tolerance = tolerance;
+    level.vertexCount = map.pointCount();
+    for (size_t ring = 0; ring < map.ringCount(); ++ring) {
+        if (map.ringSize(ring) < 2) continue;  // nothing to draw as a line strip
+        level.firsts.push_back(static_cast<GLint>(baseVertex + map.ringBegin(ring)));
+        level.counts.push_back(static_cast<GLsizei>(map.ringSize(ring)));
+    }
+
+    MapChunks chunks = splitRings(map, CHUNK_POINTS);
+    for (size_t i = 0; i < chunks.firsts.size(); ++i) {
+        level.chunkFirsts.push_back(static_cast<GLint>(baseVertex + chunks.firsts[i]));
+        level.chunkCounts.push_back(static_cast<GLsizei>(chunks.counts[i]));
+    }
+    level.chunkIndex.build(chunks.bounds);
+    levels.push_back(std::move(level));
+}
+
+/**
+ * @brief Picks the coarsest level whose simplification error stays below the given screen-space error.
+ * @param pixelsPerUnit Size of one normalized map unit on screen, in pixels.
+ * @param maxPixelError Largest acceptable deviation from the full resolution map, in pixels.
+ * @return Level index for draw().
+ */
+size_t MapMesh::selectLevel(float pixelsPerUnit, float maxPixelError) const {
+    size_t selected = 0;
+    for (size_t i = 1; i < levels.size(); ++i) {
+        if (levels[i].tolerance * pixelsPerUnit > maxPixelError) break;
+        selected = i;
+    }
+    return selected;
+}
+
+/**
+ * @brief Draws all rings of a level with one glMultiDrawArrays call.
+ * The caller binds the shader program and sets its uniforms.
+ * @param level Level index, 0 for full resolution.
+ */
+void MapMesh::draw(size_t level) const {
+    if (level >= levels.size() || levels[level].counts.empty()) return;
+    const Level& lod = levels[level];
+    glBindVertexArray(vao);
+    glMultiDrawArrays(GL_LINE_STRIP, lod.firsts.data(), lod.counts.data(), static_cast<GLsizei>(lod.counts.size()));
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Draws only the chunks of a level whose bounding box intersects the view, with one call.
+ * The caller binds the shader program and sets its uniforms.
+ * @param level Level index, 0 for full resolution.
+ * @param view Visible rectangle in normalized map units.
+ * @return Number of vertices submitted.
+ */
+size_t MapMesh::drawVisible(size_t level, const MapBounds& view) const {
+    if (level >= levels.size()) return 0;
+    const Level& lod = levels[level];
+
+    lod.chunkIndex.query(view, visibleChunks);
+    visibleFirsts.clear();
+    visibleCounts.clear();
+    size_t vertices = 0;
+    for (uint32_t chunk : visibleChunks) {
+        visibleFirsts.push_back(lod.chunkFirsts[chunk]);
+        visibleCounts.push_back(lod.chunkCounts[chunk]);
+        vertices += lod.chunkCounts[chunk];
+    }
+    if (visibleCounts.empty()) return 0;
+
+    glBindVertexArray(vao);
+    glMultiDrawArrays(GL_LINE_STRIP, visibleFirsts.data(), visibleCounts.data(),
+                      static_cast<GLsizei>(visibleCounts.size()));
+    glBindVertexArray(0);
+    return vertices;
+}
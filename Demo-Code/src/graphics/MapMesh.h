@@ -0,0 +1,71 @@
+#ifndef MAPMESH_H
+#define MAPMESH_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+#include "maps/MapLod.h"
+#include "maps/MapQuantization.h"
+#include "maps/PolylineSet.h"
+#include "maps/RingIndex.h"
+
+/**
+ * @brief GPU copy of a PolylineSet and its LOD pyramid for drawing a map with a single call.
+ * All levels are uploaded once into one static VBO of int16 grid coordinates (see MapQuantization);
+ * draw() issues one glMultiDrawArrays(GL_LINE_STRIP) over the ring ranges of the chosen level.
+ * Dequantization and placement (center and scale) are left to the shader uniforms.
+ * Each level also cuts its rings into chunks of at most CHUNK_POINTS points and indexes their bounding
+ * boxes in a RingIndex, so drawVisible() skips every piece of geometry outside the view.
+ * Meshes used for highlights can carry the centroid of each vertex's ring as a second attribute, which
+ * lets the vertex shader scale rings about their centers (see shaders/map.vert, uPulse).
+ *
+ * Implemented in MapMesh.cpp.
+ */
+class MapMesh {
+public:
+    MapMesh();
+    ~MapMesh();
+
+    static constexpr uint32_t CHUNK_POINTS = MAP_CHUNK_POINTS;
+
+    MapMesh(const MapMesh&) = delete;
+    MapMesh& operator=(const MapMesh&) = delete;
+
+    void upload(const PolylineSet& map, const std::vector<MapLod>& lods = {}, bool ringCentroids = false);
+    void draw(size_t level = 0) const;
+    size_t drawVisible(size_t level, const MapBounds& view) const;
+
+    size_t selectLevel(float pixelsPerUnit, float maxPixelError) const;
+
+    size_t getLevelCount() const { return levels.size(); }
+    float getLevelTolerance(size_t level) const { return levels[level].tolerance; }
+    size_t getLevelVertexCount(size_t level) const { return levels[level].vertexCount; }
+    size_t getLevelRingCount(size_t level) const { return levels[level].counts.size(); }
+    const MapQuantization& getQuantization() const { return quantization; }
+
+private:
+    struct Level {
+        float tolerance;                  // Simplification tolerance in map units, 0 for full resolution.
+        std::vector<GLint> firsts;        // First vertex of each drawable ring.
+        std::vector<GLsizei> counts;      // Vertex count of each drawable ring.
+        std::vector<GLint> chunkFirsts;   // First vertex of each chunk, for culled draws.
+        std::vector<GLsizei> chunkCounts; // Vertex count of each chunk.
+        RingIndex chunkIndex;             // Spatial index over the chunk bounding boxes.
+        size_t vertexCount;               // Total vertex count of the level.
+    };
+
+    GLuint vao, vbo;
+    GLuint centroidVbo;         // Per-vertex ring centroids (attribute 1), 0 if not uploaded.
+    std::vector<Level> levels;  // Level 0 is full resolution, coarser levels follow.
+    MapQuantization quantization;  // Grid of the vertex coordinates, shared by all levels.
+
+    // scratch arrays for culled draws, reused across frames
+    mutable std::vector<uint32_t> visibleChunks;
+    mutable std::vector<GLint> visibleFirsts;
+    mutable std::vector<GLsizei> visibleCounts;
+
+    void appendLevel(const PolylineSet& map, float tolerance, size_t baseVertex);
+};
+
+#endif // MAPMESH_H
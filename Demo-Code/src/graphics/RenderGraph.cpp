@@ -0,0 +1,264 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Constructor. Creates an empty graph; targets are created by the first execute().
+ */
+RenderGraph::RenderGraph() : width(1), height(1) {}
+
+/**
+ * @brief Destructor. Releases the pooled render targets.
+ */
+RenderGraph::~RenderGraph() { resize(0, 0); }
+
+/**
+ * @brief Declares a transient texture that passes can write and read.
+ * @param name Name for error messages.
+ * @param scale Size relative to the graph size, e.g. 0.5 for a half resolution bloom texture.
+ * @param format Internal format of the texture.
+ * @return Resource id.
+ */
+int RenderGraph::createTexture(const std::string& name, float scale, GLenum format) {
+    textures.push_back(Texture{name, scale, format, -1, -1});
+    return int(textures.size()) - 1;
+}
+
+/**
+ * @brief Appends a pass; passes run in the order they are added.
+ * @param name Name for error messages.
+ * @param inputs Transient textures the pass samples. A disabled pass with inputs passes the first through.
+ * @param output Transient texture or BACKBUFFER the pass renders to, covering it entirely.
+ * @param execute Issues the draw calls, with the output bound.
+ * @param enabled Whether the pass has an effect this frame; always if empty.
+ * @return Pass index.
+ */
+int RenderGraph::addPass(const std::string& name, const std::vector<int>& inputs, int output, Execute execute,
+                         Enabled enabled) {
+    for (int input : inputs) {
+        if (input < 0 || input >= int(textures.size())) {
+            std::cerr << "ERROR::RENDERGRAPH:: Pass " << name << " reads an unknown texture" << std::endl;
+        }
+    }
+    passes.push_back(Pass{name, inputs, output, std::move(execute), std::move(enabled), true, false, output, false});
+    return int(passes.size()) - 1;
+}
+
+/**
+ * @brief Sets the size of the backbuffer; transient textures scale with it. The pooled targets are
+ * released and created again at the new size as needed.
+ * @param width Framebuffer width.
+ * @param height Framebuffer height.
+ */
+void RenderGraph::resize(int width, int height) {
+    for (Target& target : pool) {
+        glDeleteFramebuffers(1, &target.fbo);
+        glDeleteTextures(1, &target.texture);
+    }
+    pool.clear();
+    this->width = width;
+    this->height = height;
+}
+
+/**
+ * @brief Decides which passes run this frame and where they write: queries enabled(), forwards disabled
+ * filters, culls passes that do not reach the screen and records when each texture is read last.
+ * Called by execute(); no GL calls are made.
+ */
+void RenderGraph::compile() {
+    for (Pass& pass : passes) {
+        pass.active = !pass.enabled || pass.enabled();
+        pass.copy = false;
+        pass.target = pass.output;
+        pass.live = false;
+    }
+
+    // Disabled filters pass their input through. Going back to front lets chains of them collapse: each one
+    // hands its target on to the pass that produces its input.
+    for (int i = int(passes.size()) - 1; i >= 0; --i) {
+        Pass& pass = passes[i];
+        if (pass.active || pass.inputs.empty()) continue;
+        const int input = pass.inputs[0];
+        const int producer = findProducer(input, i);
+        if (producer < 0) continue;  // nothing to pass through
+        bool shared = false;  // other passes read the input too, it has to stay where it is
+        for (int k = 0; k < int(passes.size()); ++k) {
+            const Pass& reader = passes[k];
+            if (k != i && reader.active &&
+                std::find(reader.inputs.begin(), reader.inputs.end(), input) != reader.inputs.end()) {
+                shared = true;
+            }
+        }
+        if (shared) {
+            pass.copy = true;
+        } else {
+            passes[producer].target = pass.target;
+        }
+    }
+
+    // Back to front: a pass is live if a later live pass reads its target, or the target is the backbuffer
+    // and no later pass overwrites it.
+    std::vector<int> demanded{BACKBUFFER};
+    for (int i = int(passes.size()) - 1; i >= 0; --i) {
+        Pass& pass = passes[i];
+        if (!pass.active && !pass.copy) continue;
+        auto it = std::find(demanded.begin(), demanded.end(), pass.target);
+        if (it == demanded.end()) continue;  // culled
+        pass.live = true;
+        demanded.erase(it);  // what earlier passes wrote there is overwritten
+        const size_t reads = pass.copy ? 1 : pass.inputs.size();
+        for (size_t k = 0; k < reads; ++k) {
+            if (std::find(demanded.begin(), demanded.end(), pass.inputs[k]) == demanded.end()) {
+                demanded.push_back(pass.inputs[k]);
+            }
+        }
+    }
+
+    for (Texture& texture : textures) texture.lastRead = -1;
+    for (int i = 0; i < int(passes.size()); ++i) {
+        const Pass& pass = passes[i];
+        if (!pass.live) continue;
+        const size_t reads = pass.copy ? 1 : pass.inputs.size();
+        for (size_t k = 0; k < reads; ++k) textures[pass.inputs[k]].lastRead = i;
+    }
+}
+
+/**
+ * @brief Compiles the graph for this frame and runs the live passes, binding each pass's target and
+ * handing pooled targets from textures that are no longer read to the ones written next.
+ * Leaves the default framebuffer bound.
+ */
+void RenderGraph::execute() {
+    compile();
+    for (Texture& texture : textures) texture.target = -1;
+    for (Target& target : pool) target.inUse = false;
+
+    for (int i = 0; i < int(passes.size()); ++i) {
+        Pass& pass = passes[i];
+        if (!pass.live) continue;
+        bind(pass.target);
+        if (pass.copy) {
+            const Texture& input = textures[pass.inputs[0]];
+            if (input.target >= 0) {
+                const Target& source = pool[input.target];
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, source.fbo);
+                int w = width, h = height;
+                if (pass.target != BACKBUFFER) {
+                    const Target& destination = pool[textures[pass.target].target];
+                    w = destination.width;
+                    h = destination.height;
+                }
+                glBlitFramebuffer(0, 0, source.width, source.height, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+            }
+        } else {
+            pass.run(*this);
+        }
+
+        // targets of textures read for the last time go back to the pool
+        for (int input : pass.inputs) {
+            Texture& texture = textures[input];
+            if (texture.lastRead == i && texture.target >= 0) {
+                pool[texture.target].inUse = false;
+                texture.target = -1;
+            }
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Texture holding a transient resource while the passes reading it run.
+ * @param resource Resource id from createTexture().
+ * @return The GL texture, or 0 if nothing wrote the resource this frame.
+ */
+GLuint RenderGraph::getTexture(int resource) const {
+    if (resource < 0 || resource >= int(textures.size()) || textures[resource].target < 0) return 0;
+    return pool[textures[resource].target].texture;
+}
+
+/**
+ * @brief Number of passes that ran in the last execute().
+ */
+int RenderGraph::getLivePassCount() const {
+    return int(std::count_if(passes.begin(), passes.end(), [](const Pass& pass) { return pass.live; }));
+}
+
+/**
+ * @brief GPU memory of the pooled targets, counting 4 bytes per pixel (8 for half float formats).
+ */
+size_t RenderGraph::getTargetBytes() const {
+    size_t bytes = 0;
+    for (const Target& target : pool) {
+        const bool half = target.format == GL_RGB16F || target.format == GL_RGBA16F;
+        bytes += size_t(target.width) * target.height * (half ? 8 : 4);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Last pass before another one that writes a resource or forwards to it.
+ * @param resource Resource written.
+ * @param beforePass Pass index to search before.
+ * @return Pass index, or -1.
+ */
+int RenderGraph::findProducer(int resource, int beforePass) const {
+    for (int i = beforePass - 1; i >= 0; --i) {
+        const Pass& pass = passes[i];
+        if (pass.target == resource && (pass.active || !pass.inputs.empty())) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Takes a free pooled target matching the size and format of a texture, creating one if needed.
+ * @param texture Transient texture to back.
+ * @return Index into the pool.
+ */
+int RenderGraph::acquire(const Texture& texture) {
+    const int w = std::max(1, int(width * texture.scale + 0.5f));
+    const int h = std::max(1, int(height * texture.scale + 0.5f));
+    for (int i = 0; i < int(pool.size()); ++i) {
+        Target& target = pool[i];
+        if (!target.inUse && target.width == w && target.height == h && target.format == texture.format) {
+            target.inUse = true;
+            return i;
+        }
+    }
+
+    Target target{0, 0, w, h, texture.format, true};
+    glGenFramebuffers(1, &target.fbo);
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, texture.format, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::RENDERGRAPH:: Framebuffer for " << texture.name << " is not complete!" << std::endl;
+    }
+    pool.push_back(target);
+    return int(pool.size()) - 1;
+}
+
+/**
+ * @brief Binds the framebuffer a pass writes and sets the viewport to its size; a transient texture
+ * gets a pooled target the first time it is written in a frame.
+ * @param resource Transient texture or BACKBUFFER.
+ */
+void RenderGraph::bind(int resource) {
+    if (resource == BACKBUFFER) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, width, height);
+        return;
+    }
+    Texture& texture = textures[resource];
+    if (texture.target < 0) texture.target = acquire(texture);
+    const Target& target = pool[texture.target];
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.width, target.height);
+}
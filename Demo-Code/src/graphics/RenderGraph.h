@@ -0,0 +1,96 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include <glad/glad.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A small frame graph for the full screen passes of a frame (scene, CRT, TV collapse, ...).
+ *
+ * Passes are added once, in execution order, each declaring the textures it reads and the one target it
+ * writes: a transient texture created with createTexture() or the default framebuffer (BACKBUFFER). A pass
+ * must cover its whole target, so a later pass writing the same target replaces what an earlier one wrote.
+ * Every frame execute() works out which passes matter before running them:
+ * - A pass whose enabled() returns false does nothing. If it has inputs it is a filter and passes its
+ *   first input through: the pass producing that input writes the filter's target instead (or, if
+ *   other passes read the input as well, the input is copied there).
+ * - Passes whose target is not read by a later pass and is not what ends up on the screen are culled,
+ *   together with everything only they read.
+ * - Transient textures exist only from the pass writing them to the last pass reading them. They are
+ *   backed by a pool of render targets (framebuffer + texture); a target is returned to the pool after the
+ *   last read and reused by the next texture of the same size and format. A chain of filters therefore
+ *   alternates between two targets however long it gets.
+ * Before a pass runs its target is bound and the viewport set to its size; getTexture() gives the
+ * textures of its inputs.
+ *
+ * Implemented in RenderGraph.cpp.
+ */
+class RenderGraph {
+   public:
+    static constexpr int BACKBUFFER = -1;  ///< Resource id of the default framebuffer.
+
+    using Execute = std::function<void(RenderGraph& graph)>;
+    using Enabled = std::function<bool()>;
+
+    RenderGraph();
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    int createTexture(const std::string& name, float scale = 1.0f, GLenum format = GL_RGB8);
+    int addPass(const std::string& name, const std::vector<int>& inputs, int output, Execute execute,
+                Enabled enabled = {});
+    void resize(int width, int height);
+
+    void compile();
+    void execute();
+
+    GLuint getTexture(int resource) const;
+    bool isPassLive(int pass) const { return passes[pass].live; }
+    int getLivePassCount() const;
+    size_t getTargetCount() const { return pool.size(); }
+    size_t getTargetBytes() const;
+
+   private:
+    struct Texture {
+        std::string name;
+        float scale;    // Size relative to the graph size.
+        GLenum format;  // Internal format.
+        int target;     // Pool target backing it during execute(), -1 if none.
+        int lastRead;   // Last live pass reading it.
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<int> inputs;
+        int output;
+        Execute run;
+        Enabled enabled;
+        bool active;  // Enabled this frame.
+        bool copy;    // Disabled filter whose input is copied to its output.
+        int target;   // Output after pass-through forwarding.
+        bool live;    // Runs this frame.
+    };
+
+    struct Target {
+        GLuint fbo, texture;
+        int width, height;
+        GLenum format;
+        bool inUse;
+    };
+
+    std::vector<Texture> textures;
+    std::vector<Pass> passes;
+    std::vector<Target> pool;
+    int width, height;
+
+    int findProducer(int resource, int beforePass) const;
+    int acquire(const Texture& texture);
+    void bind(int resource);
+};
+
+#endif  // RENDERGRAPH_H
@@ -3,24 +3,47 @@
 #include <sstream>
 #include <iostream>
 
+/**
+ * @brief Inserts preprocessor lines into shader source, after the #version line that has to come first.
+ * @param code Shader source.
+ * @param defines Lines to insert, each ending in a newline.
+ */
+static void insertDefines(std::string& code, const std::string& defines) {
+    if (defines.empty()) return;
+    size_t pos = 0;                                             // Start of the source if it has no #version line
+    if (code.compare(0, 8, "#version") == 0) {
+        pos = code.find('\n');
+        if (pos == std::string::npos) {
+            code += '\n';
+            pos = code.size() - 1;
+        }
+        ++pos;
+    }
+    code.insert(pos, defines);
+}
+
 /**
  * @brief Loads a shader program from vertex and fragment shader files.
  * @param vsPath Path to the vertex shader file.
  * @param fsPath Path to the fragment shader file.
+ * @param defines Preprocessor lines (e.g. "#define TV_COLLAPSE\n") inserted into both shaders after the #version line,
+ *                to compile specialized variants of one source.
  * @return The shader program ID.
  * This function reads the shader source code from the specified files, compiles the shaders, links them into a program, and returns the program ID.
  */
-GLuint ShaderManager::loadShader(const char* vsPath, const char* fsPath) {
+GLuint ShaderManager::loadShader(const char* vsPath, const char* fsPath, const std::string& defines) {
     std::ifstream vsFile(vsPath);                               // Open the vertex shader file                      
     std::stringstream vsStream;                                 // Create a string stream to read the file contents  
     vsStream << vsFile.rdbuf();                                 // Read the file contents into the string stream
     std::string vsCode = vsStream.str();                        // Convert the string stream to a string
+    insertDefines(vsCode, defines);                             // Specialize the shader, if requested
     const char* vShaderCode = vsCode.c_str();                   // Get the C-style string from the vertex shader code
 
     std::ifstream fsFile(fsPath);                               // Open the fragment shader file, ff. same process as above
     std::stringstream fsStream;
     fsStream << fsFile.rdbuf();
     std::string fsCode = fsStream.str();
+    insertDefines(fsCode, defines);
     const char* fShaderCode = fsCode.c_str();
 
     GLuint vertex = glCreateShader(GL_VERTEX_SHADER);           // Create a vertex shader object
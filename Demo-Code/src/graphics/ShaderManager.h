@@ -12,7 +12,7 @@
  */
 class ShaderManager {
 public:
-    static GLuint loadShader(const char* vsPath, const char* fsPath);
+    static GLuint loadShader(const char* vsPath, const char* fsPath, const std::string& defines = "");
 };
 
 #endif // SHADERMANAGER_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <climits>
+
+/**
+ * @brief Constructor.
+ * @param width Width of the area to pack into.
+ * @param height Height of the area to pack into.
+ */
+SkylinePacker::SkylinePacker(int width, int height) { reset(width, height); }
+
+/**
+ * @brief Forgets all placed rectangles and starts over with an empty area.
+ * @param width Width of the area to pack into.
+ * @param height Height of the area to pack into.
+ */
+void SkylinePacker::reset(int width, int height) {
+    this->width = width;
+    this->height = height;
+    usedArea = 0;
+    skyline.clear();
+    skyline.push_back({0, 0, width});
+}
+
+/**
+ * @brief Makes the area taller without moving anything already placed.
+ * @param height New height; ignored if smaller than the current one.
+ */
+void SkylinePacker::growHeight(int height) { this->height = std::max(this->height, height); }
+
+/**
+ * @brief Continues packing from a saved state, e.g. an atlas loaded from disk.
+ * @param width Width of the area to pack into.
+ * @param height Height of the area to pack into.
+ * @param skyline Outline from getSkyline() of the packer that filled the area.
+ * @param usedArea Value of getUsedArea() of that packer.
+ * @return False if the outline does not cover [0, width) in order or exceeds the height; the packer is
+ *         reset to the empty area then.
+ */
+bool SkylinePacker::restore(int width, int height, const std::vector<Segment>& skyline, size_t usedArea) {
+    reset(width, height);
+    int x = 0;
+    for (const auto& segment : skyline) {
+        if (segment.x != x || segment.width <= 0 || segment.y < 0 || segment.y > height) return false;
+        x += segment.width;
+    }
+    if (x != width) return false;
+
+    this->skyline = skyline;
+    this->usedArea = usedArea;
+    return true;
+}
+
+/**
+ * @brief Finds a place for a rectangle and reserves it.
+ * @param w Rectangle width.
+ * @param h Rectangle height.
+ * @param pos Receives the top-left corner (y grows downwards, like texture rows).
+ * @return False if the rectangle does not fit anywhere.
+ */
+bool SkylinePacker::insert(int w, int h, glm::ivec2& pos) {
+    if (w <= 0 || h <= 0) {
+        pos = glm::ivec2(0, 0);
+        return true;  // nothing to reserve
+    }
+
+    int bestBottom = INT_MAX, bestWidth = INT_MAX;
+    size_t bestIndex = skyline.size();
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y = fit(i, w, h);
+        if (y < 0) continue;
+        // lowest bottom edge first, then the narrowest segment to keep wide gaps for wide rectangles
+        if (y + h < bestBottom || (y + h == bestBottom && skyline[i].width < bestWidth)) {
+            bestBottom = y + h;
+            bestWidth = skyline[i].width;
+            bestIndex = i;
+            pos = glm::ivec2(skyline[i].x, y);
+        }
+    }
+    if (bestIndex == skyline.size()) return false;
+
+    place(bestIndex, pos.x, pos.y, w, h);
+    usedArea += size_t(w) * size_t(h);
+    return true;
+}
+
+/**
+ * @brief Height of the tallest point of the outline, i.e. the rows in use.
+ */
+int SkylinePacker::getUsedHeight() const {
+    int used = 0;
+    for (const auto& segment : skyline) used = std::max(used, segment.y);
+    return used;
+}
+
+/**
+ * @brief Computes where a rectangle would rest if its left edge starts at segment index.
+ * @return Top y of the rectangle, or -1 if it would leave the area.
+ */
+int SkylinePacker::fit(size_t index, int w, int h) const {
+    int x = skyline[index].x;
+    if (x + w > width) return -1;
+
+    int y = skyline[index].y;
+    int remaining = w;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i == skyline.size()) return -1;
+        y = std::max(y, skyline[i].y);
+        if (y + h > height) return -1;
+        remaining -= skyline[i].width;
+    }
+    return y;
+}
+
+/**
+ * @brief Raises the outline over a placed rectangle and merges segments of equal height.
+ */
+void SkylinePacker::place(size_t index, int x, int y, int w, int h) {
+    skyline.insert(skyline.begin() + index, Segment{x, y + h, w});
+
+    // cut the segments now hidden below the new one
+    for (size_t i = index + 1; i < skyline.size();) {
+        const Segment& prev = skyline[i - 1];
+        int overlap = prev.x + prev.width - skyline[i].x;
+        if (overlap <= 0) break;
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SKYLINEPACKER_H
+#define SKYLINEPACKER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @brief Rectangle packer for texture atlases using the skyline bottom-left heuristic.
+ *
+ * The packer tracks the upper outline ("skyline") of everything placed so far as a list of horizontal
+ * segments. A new rectangle goes where its bottom edge ends up lowest, which keeps the outline flat and
+ * wastes little space for glyph-shaped rectangles. Rectangles can be added one at a time, so the same
+ * packer serves both atlases built in one go and atlases that grow while the program runs.
+ *
+ * Implemented in SkylinePacker.cpp.
+ */
+class SkylinePacker {
+public:
+    struct Segment {
+        int x, y, width;  // Segment of the outline: [x, x + width) is covered up to y.
+    };
+
+    SkylinePacker(int width = 0, int height = 0);
+
+    void reset(int width, int height);
+    void growHeight(int height);
+    bool restore(int width, int height, const std::vector<Segment>& skyline, size_t usedArea);
+    bool insert(int w, int h, glm::ivec2& pos);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getUsedHeight() const;
+    size_t getUsedArea() const { return usedArea; }
+    const std::vector<Segment>& getSkyline() const { return skyline; }
+
+private:
+    int width, height;
+    size_t usedArea;
+    std::vector<Segment> skyline;  // Sorted by x, covering [0, width) without gaps.
+
+    int fit(size_t index, int w, int h) const;
+    void place(size_t index, int x, int y, int w, int h);
+};
+
+#endif // SKYLINEPACKER_H
@@ -0,0 +1,116 @@
+#include "TextRun.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Font.h"
+
+/**
+ * @brief Destructor. Deletes the vertex buffer.
+ */
+TextRun::~TextRun() { release(); }
+
+/**
+ * @brief Move constructor. Takes over the buffer of another run, which is left empty.
+ */
+TextRun::TextRun(TextRun&& other) noexcept { *this = std::move(other); }
+
+/**
+ * @brief Move assignment. Takes over the buffer of another run, which is left empty.
+ */
+TextRun& TextRun::operator=(TextRun&& other) noexcept {
+    if (this != &other) {
+        release();
+        vao = std::exchange(other.vao, 0);
+        vbo = std::exchange(other.vbo, 0);
+        vertexCount = std::exchange(other.vertexCount, 0);
+        bufferCapacity = std::exchange(other.bufferCapacity, 0);
+        text = std::move(other.text);
+        scale = other.scale;
+        color = other.color;
+        cursor = other.cursor;
+        font = std::exchange(other.font, nullptr);
+        fontVersion = other.fontVersion;
+        width = other.width;
+    }
+    return *this;
+}
+
+/**
+ * @brief Lays the text out again if it, the font, the scale or the color changed since the last call.
+ * Cheap when nothing changed, so it can be called every frame with the current text.
+ * @param font Font to lay out with; glyphs not in its atlas yet are rasterized.
+ * @param text UTF-8 text.
+ * @param scale Scaling factor, as for Font::renderText().
+ * @param color Text color (RGB).
+ * @param cursor Whether draw() may show an underscore cursor after the revealed prefix.
+ * @return True if the quads were rebuilt.
+ */
+bool TextRun::update(Font& font, const std::string& text, float scale, const glm::vec3& color, bool cursor) {
+    if (this->font == &font && fontVersion == font.getLayoutVersion() && this->scale == scale &&
+        this->color == color && this->cursor == cursor && this->text == text) {
+        return false;
+    }
+
+    std::vector<Font::TextVertex> vertices;
+    for (int layouts = 1;; ++layouts) {
+        // loading a glyph may evict the atlas and move the glyphs laid out before it
+        vertices.clear();
+        fontVersion = font.getLayoutVersion();
+        width = font.layoutText(text, 0.0f, 0.0f, scale, color, vertices, cursor);
+        // a second eviction means the text has more glyphs than the atlas holds; keep what resolved, the
+        // stale fontVersion lays it out again next time
+        if (fontVersion == font.getLayoutVersion() || layouts == 2) break;
+    }
+
+    this->font = &font;
+    this->text = text;
+    this->scale = scale;
+    this->color = color;
+    this->cursor = cursor;
+    vertexCount = static_cast<GLsizei>(vertices.size());
+
+    if (!vao) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        Font::setVertexLayout();
+        glBindVertexArray(0);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (vertices.size() > bufferCapacity) {
+        bufferCapacity = vertices.size();
+        glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(Font::TextVertex), vertices.data(), GL_STATIC_DRAW);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Font::TextVertex), vertices.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+/**
+ * @brief Queues the run with its baseline origin at (x, y); drawn by the next Font::flush().
+ * @param font Font the run was laid out with in update().
+ * @param x X position.
+ * @param y Y position (baseline).
+ * @param visibleBytes Length in bytes of the prefix of the text to show, e.g. what has been typed so far;
+ * npos shows all of it. Glyphs keep the positions they have in the whole text.
+ * @param showCursor Whether to show the cursor after the prefix (the run must be laid out with one).
+ */
+void TextRun::draw(Font& font, float x, float y, size_t visibleBytes, bool showCursor) const {
+    if (this->font != &font || vertexCount == 0) return;
+    font.queueRun(*this, x, y, std::min(visibleBytes, text.size()), showCursor);
+}
+
+/**
+ * @brief Deletes the vertex array and buffer.
+ */
+void TextRun::release() {
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    vao = vbo = 0;
+    vertexCount = 0;
+    bufferCapacity = 0;
+}
@@ -0,0 +1,60 @@
+#ifndef TEXTRUN_H
+#define TEXTRUN_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+
+class Font;
+
+/**
+ * @brief A string laid out once into glyph quads that live in a vertex buffer of their own.
+ *
+ * For text that stays the same over many frames (labels, finished terminal lines). update() lays the text
+ * out relative to its baseline origin and uploads the quads; draw() queues the buffer with Font at a
+ * position, which is applied as a translation uniform, so redrawing costs no layout and no upload.
+ * Typing animations lay out the whole text once and pass the length of the typed prefix to draw(); the
+ * vertex shader hides the rest and shows a cursor after the prefix if the run was laid out with one.
+ * The layout is redone only when the text, the font, the scale or the color changes, or when the font
+ * moved its glyphs (new atlas or new pixel height, see Font::getLayoutVersion()).
+ * The run must stay alive until the Font::flush() that draws it.
+ *
+ * Implemented in TextRun.cpp.
+ */
+class TextRun {
+public:
+    TextRun() = default;
+    ~TextRun();
+
+    TextRun(const TextRun&) = delete;
+    TextRun& operator=(const TextRun&) = delete;
+    TextRun(TextRun&& other) noexcept;
+    TextRun& operator=(TextRun&& other) noexcept;
+
+    bool update(Font& font, const std::string& text, float scale, const glm::vec3& color, bool cursor = false);
+    void draw(Font& font, float x, float y, size_t visibleBytes = std::string::npos, bool showCursor = false) const;
+
+    const std::string& getText() const { return text; }
+    float getWidth() const { return width; }
+
+private:
+    friend class Font;
+
+    GLuint vao = 0, vbo = 0;
+    GLsizei vertexCount = 0;
+    size_t bufferCapacity = 0;  // Size of vbo in vertices.
+
+    std::string text;
+    float scale = 0.0f;
+    glm::vec3 color{0.0f};
+    bool cursor = false;         // Cursor quads laid out.
+    const Font* font = nullptr;  // Font the quads were laid out with.
+    uint32_t fontVersion = 0;    // Font::getLayoutVersion() at layout time.
+    float width = 0.0f;          // Pen advance over the text.
+
+    void release();
+};
+
+#endif // TEXTRUN_H
@@ -7,6 +7,7 @@
 
 #include "graphics/CRTEffect.h"
 #include "graphics/Font.h"
+#include "graphics/RenderGraph.h"
 #include "graphics/ShaderManager.h"
 
 #include "core/Config.h"
@@ -14,7 +15,6 @@
 
 #include "scenes/LoginScene.h"
 #include "scenes/LocateScene.h"
-#include "scenes/TVEffectScene.h"
 #include "scenes/TerminalScene.h"
 
 #include "audio/SoundManager.h"
@@ -138,24 +138,20 @@ int main() {
     LocateScene locateScene;
     locateScene.setSoundManager(&soundManager);
 
-    TVEffectScene tvEffectScene;
-    tvEffectScene.setSoundManager(&soundManager);
-
     int width, height;
     windowManager.getFramebufferSize(width, height);
-    tvEffectScene.initialize(width, height);
 
     TerminalScene terminalAnimation;
     terminalAnimation.setOnTypeCallback([&soundManager]() { soundManager.playRandomSound(); });
+    if (!Config::terminalSession.empty()) terminalAnimation.loadSession(Config::terminalSession);
 
     loginScene.setOnTypeCallback([&soundManager]() { soundManager.playRandomSound(); });
 
     CRTEffect crtEffect;
-    if (!crtEffect.initialize(width, height)) {
+    if (!crtEffect.initialize()) {
         std::cerr << "Failed to initialize CRT effect.\n";
         return -1;
     }
-    tvEffectScene.setCRTEffect(&crtEffect);
 
     glm::vec3 textColor(0.0f, 1.0f, 0.0f);  // Consistent green color
     int lastFontSize = 0;
@@ -185,10 +181,61 @@ int main() {
 
     int latFontSize = 0;
     int lastWidth = 0, lastHeight = 0;
+    float now = lastTime;
+    AppState frameState = appState;  // State the frame started in, whose scene is drawn
+
+    // Post-processing: the scene is drawn into a texture that the CRT pass distorts onto the screen; during
+    // transitions the CRT pass also folds the picture away (TV collapse), and the black screen replaces all of
+    // it. Passes without an effect in the current state are culled by the graph.
+    RenderGraph renderGraph;
+    const int sceneColor = renderGraph.createTexture("scene");
+    renderGraph.addPass("scene", {}, sceneColor, [&](RenderGraph&) {
+        // Set up font rendering projection
+        glm::mat4 projection = glm::ortho(0.0f, float(width), 0.0f, float(height));
+        glUseProgram(font.getShaderProgram());
+        glUniformMatrix4fv(glGetUniformLocation(font.getShaderProgram(), "projection"), 1, GL_FALSE,
+                           &projection[0][0]);
+        font.setScreenWidth(width);
+
+        glClearColor(0.0f, 0.1f, 0.0f, 1.0f);  // Maintain green background
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        float lineSpacing = float(lastFontSize) * 1.0f;
+        switch (frameState) {
+            case STATE_LOGIN:
+                loginScene.render(font, height / 2.0f, lineSpacing, now, textColor);
+                break;
+            case STATE_TERMINAL:
+                terminalAnimation.render(font, height - lastFontSize * 2, lineSpacing, now, textColor, width, height);
+                break;
+            case STATE_LOCATE:
+                locateScene.render(font, height / 2.0f, lineSpacing, now, textColor, width, height);
+                break;
+            default:
+                break;  // transitions show the green background only
+        }
+        font.flush();  // all text of the frame in one draw call
+    });
+    renderGraph.addPass("crt", {sceneColor}, RenderGraph::BACKBUFFER, [&](RenderGraph& graph) {
+        const bool transition = appState == STATE_COLLAPSE || appState == STATE_REBUILD ||
+                                appState == STATE_RESET_COLLAPSE || appState == STATE_RESET_REBUILD;
+        crtEffect.render(graph.getTexture(sceneColor), now, transition ? tvCloseAnim : 0.0f);  // fused collapse
+    });
+    renderGraph.addPass(
+        "black screen", {}, RenderGraph::BACKBUFFER,
+        [&](RenderGraph&) {
+            // Smooth black screen transition
+            float t = (now - blackScreenStartTime) / 1.0f;
+            float fade = easeInQuad(std::min(t, 1.0f));
+            glClearColor(0.0f, 0.1f * (1.0f - fade), 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        },
+        [&]() { return appState == STATE_BLACKSCREEN || appState == STATE_RESET_BLACKSCREEN; });
 
     // Main loop
     while (!windowManager.shouldClose()) {
-        float now = glfwGetTime();
+        now = glfwGetTime();
+        frameState = appState;
         float deltaTime = now - lastTime;
         lastTime = now;
 
@@ -197,47 +244,18 @@ int main() {
         // Dynamic font size adjustment
         if (width != lastWidth || height != lastHeight) {
             int fontPixelSize = std::max(16, height / 32);               // font size based on height
-            font.load("assets/fonts/VT323-Regular.ttf", fontPixelSize);  
+            font.setPixelHeight(fontPixelSize);  // the SDF atlas scales, no reload
             lastFontSize = fontPixelSize;
             lastWidth = width;
             lastHeight = height;
             font.setScreenWidth(width);
+            renderGraph.resize(width, height);
         }
 
-        if (width != crtEffect.getWidth() || height != crtEffect.getHeight()) {
-            crtEffect.resize(width, height);
-            tvEffectScene.resize(width, height);
-        }
-
-        // Clear screen with green background (slightly darker than text for contrast)
-        glClearColor(0.0f, 0.1f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // Set up font rendering projection
-        if (appState != STATE_BLACKSCREEN && appState != STATE_RESET_BLACKSCREEN) {
-            glm::mat4 projection = glm::ortho(0.0f, float(width), 0.0f, float(height));
-            glUseProgram(font.getShaderProgram());
-            glUniformMatrix4fv(glGetUniformLocation(font.getShaderProgram(), "projection"), 1, GL_FALSE,
-                               &projection[0][0]);
-
-            font.setScreenWidth(width);
-        }
-
-        float lineSpacing = float(lastFontSize) * 1.0f;
-        float y;
-
-        // Begin rendering to CRT framebuffer
-        if (appState != STATE_BLACKSCREEN && appState != STATE_RESET_BLACKSCREEN) {
-            crtEffect.beginRender();
-            glClearColor(0.0f, 0.1f, 0.0f, 1.0f);  // Maintain green background
-            glClear(GL_COLOR_BUFFER_BIT);
-        }
-
+        // Update the scenes and advance the state machine; drawing is done by the render graph below
         switch (appState) {
             case STATE_LOGIN: {
-                y = height / 2.0f;
                 loginScene.update(deltaTime);
-                loginScene.render(font, y, lineSpacing, now, textColor);
 
                 if (loginScene.isFinished()) {
                     appState = STATE_TERMINAL;
@@ -251,9 +269,7 @@ int main() {
             }
 
             case STATE_TERMINAL: {
-                y = height - lastFontSize * 2;
                 terminalAnimation.update(now);
-                terminalAnimation.render(font, y, lineSpacing, now, textColor);
 
                 if (terminalAnimation.isFinished()) {
                     appState = STATE_COLLAPSE;
@@ -298,9 +314,7 @@ int main() {
             }
 
             case STATE_LOCATE: {
-                y = height / 2.0f;
                 locateScene.update(deltaTime);
-                locateScene.render(font, y, lineSpacing, now, textColor, width, height);
 
                 if (firstLocateEnter) {
                     locateSceneStartTime = now;
@@ -361,35 +375,10 @@ int main() {
             }
         }
 
-        // End rendering to CRT buffer
-        if (appState != STATE_BLACKSCREEN && appState != STATE_RESET_BLACKSCREEN) {
-            crtEffect.endRender();
-        }
-
-        // Render final output
-        if (appState == STATE_BLACKSCREEN || appState == STATE_RESET_BLACKSCREEN) {
-            // Smooth black screen transition
-            float t = (appState == STATE_BLACKSCREEN) ? (now - blackScreenStartTime) / 1.0f
-                                                      : (now - blackScreenStartTime) / 1.0f;
-
-            float fade =
-                (appState == STATE_BLACKSCREEN) ? easeInQuad(std::min(t, 1.0f)) : easeInQuad(std::min(t, 1.0f));
-
-            glClearColor(0.0f, 0.1f * (1.0f - fade), 0.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
-        } else if (appState == STATE_COLLAPSE || appState == STATE_REBUILD || appState == STATE_RESET_COLLAPSE ||
-                   appState == STATE_RESET_REBUILD) {
-            // Render CRT effect with TV overlay
-            crtEffect.render(now);
-            tvEffectScene.render(now, tvCloseAnim);
-        } else {
-            // Normal scene rendering with CRT effect
-            crtEffect.render(now);
-        }
+        renderGraph.execute();
 
         windowManager.swapBuffers();
         windowManager.pollEvents();
     }
-    tvEffectScene.cleanup();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "GeoJSONLoader.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "json.hpp"
+using json = nlohmann::json;
+
+namespace {
+
+/**
+ * @brief SAX handler that extracts the rings of every feature geometry.
+ *
+ * Instead of switching on the geometry type (which may appear after "coordinates" in the file), the
+ * nesting inside "coordinates" is interpreted structurally: an array of numbers is a point and an array
+ * of points is a ring. Points are normalized and appended directly to the flat point array, and each
+ * finished ring closes with an entry in the offset table; there are no temporary rings.
+ */
+class GeoJSONSaxHandler : public nlohmann::json_sax<json> {
+   public:
+    GeoJSONSaxHandler(std::vector<glm::vec2>& points, std::vector<uint32_t>& offsets, const MapNorm& norm)
+        : points(points), offsets(offsets), norm(norm) {}
+
+    bool null() override { return value(); }
+    bool boolean(bool) override { return value(); }
+    bool number_integer(number_integer_t val) override { return number(static_cast<double>(val)); }
+    bool number_unsigned(number_unsigned_t val) override { return number(static_cast<double>(val)); }
+    bool number_float(number_float_t val, const string_t&) override { return number(val); }
+    bool string(string_t&) override { return value(); }
+    bool binary(binary_t&) override { return value(); }
+
+    bool start_object(std::size_t) override {
+        depth++;
+        if (geometryKey) geometryDepth = depth;
+        geometryKey = coordinatesKey = false;
+        return true;
+    }
+
+    bool end_object() override {
+        if (depth == geometryDepth) geometryDepth = -1;
+        depth--;
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        // keys are handed out by reference to the lexer buffer, comparing them does not allocate
+        geometryKey = (val == "geometry");
+        coordinatesKey = (depth == geometryDepth && val == "coordinates");
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        depth++;
+        if (coordinatesKey) {
+            coordLevel = 1;
+        } else if (coordLevel > 0) {
+            coordLevel++;
+        }
+        geometryKey = coordinatesKey = false;
+        return true;
+    }
+
+    bool end_array() override {
+        if (coordLevel > 0) {
+            if (coordLevel == pointLevel) {
+                // closing a point: it belongs to the ring one level up (a bare Point geometry is ignored)
+                if (components >= 2 && coordLevel >= 2) {
+                    ringLevel = coordLevel - 1;  // closed again (and recorded) by end_array of the ring
+                    float x = float((point[0] - norm.lon_min) / (norm.lon_max - norm.lon_min) * 2.0 - 1.0);
+                    float y = float((point[1] - norm.lat_min) / (norm.lat_max - norm.lat_min) * 2.0 - 1.0);
+                    points.emplace_back(x, y);
+                }
+                pointLevel = -1;
+                components = 0;
+            } else if (coordLevel == ringLevel) {
+                offsets.push_back(static_cast<uint32_t>(points.size()));
+                ringLevel = -1;
+            }
+            coordLevel--;
+        }
+        depth--;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+        std::cerr << "GeoJSON parse error at byte " << position << ": " << ex.what() << "\n";
+        return false;
+    }
+
+   private:
+    bool value() {
+        geometryKey = coordinatesKey = false;
+        return true;
+    }
+
+    bool number(double val) {
+        if (coordLevel > 0) {
+            if (components < 2) point[components] = val;  // ignore altitude
+            components++;
+            pointLevel = coordLevel;
+        }
+        return value();
+    }
+
+    std::vector<glm::vec2>& points;
+    std::vector<uint32_t>& offsets;
+    const MapNorm& norm;
+
+    int depth = 0;               // Current container depth (objects and arrays).
+    int geometryDepth = -1;      // Depth of the current "geometry" object, -1 outside of one.
+    bool geometryKey = false;    // Last key was "geometry".
+    bool coordinatesKey = false; // Last key was "coordinates" inside a geometry object.
+
+    int coordLevel = 0;          // Array nesting level inside "coordinates", 0 outside.
+    int pointLevel = -1;         // Level of the array currently collecting point components.
+    int ringLevel = -1;          // Level of the array currently receiving points.
+    double point[2] = {0.0, 0.0};
+    int components = 0;
+};
+
+}  // namespace
+
+/**
+ * @brief Load map data from a GeoJSON file and normalize coordinates.
+ * @param filename Path to the GeoJSON file.
+ * @param norm Normalization parameters.
+ * @return Normalized polylines. Empty on failure.
+ */
+PolylineSet loadMapFromGeoJSON(const std::string& filename, const MapNorm& norm) {
+    std::ifstream infile(filename, std::ios::binary);
+    if (!infile) {
+        std::cerr << "Failed to open map: " << filename << "\n";
+        return PolylineSet();
+    }
+
+    std::vector<glm::vec2> points;
+    std::vector<uint32_t> offsets{0};
+    GeoJSONSaxHandler handler(points, offsets, norm);
+    if (!json::sax_parse(infile, &handler)) {
+        std::cerr << "Failed to parse map: " << filename << "\n";
+        return PolylineSet();
+    }
+    points.shrink_to_fit();
+    return PolylineSet::fromArrays(std::move(points), std::move(offsets));
+}
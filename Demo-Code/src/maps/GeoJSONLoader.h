@@ -0,0 +1,30 @@
+#ifndef GEOJSONLOADER_H
+#define GEOJSONLOADER_H
+
+#include <glm/glm.hpp>
+#include <string>
+
+#include "PolylineSet.h"
+
+/**
+ * @brief Map normalization parameters for longitude and latitude.
+ */
+struct MapNorm {
+    float lon_min, lon_max, lat_min, lat_max;
+};
+
+/**
+ * @brief Load map data from a GeoJSON file and normalize coordinates.
+ *
+ * The file is streamed through the SAX interface of nlohmann::json, so no DOM is built. Only the
+ * numbers below "geometry"/"coordinates" are materialized; "properties" and every other subtree are
+ * tokenized and dropped without allocating. Polygon, MultiPolygon and LineString geometries are supported.
+ * Points are appended straight to the flat arrays of the returned PolylineSet.
+ *
+ * @param filename Path to the GeoJSON file.
+ * @param norm Normalization parameters.
+ * @return Normalized polylines. Empty on failure.
+ */
+PolylineSet loadMapFromGeoJSON(const std::string& filename, const MapNorm& norm);
+
+#endif  // GEOJSONLOADER_H
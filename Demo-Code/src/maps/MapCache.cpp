@@ -0,0 +1,143 @@
+#include "MapCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "core/Hash.h"
+#include "core/MappedFile.h"
+
+namespace {
+
+constexpr char MAP_CACHE_MAGIC[4] = {'R', 'T', 'M', 'C'};
+
+/**
+ * @brief Offset of the point array behind the header and ring offset table (8 byte aligned).
+ */
+size_t pointsOffset(uint32_t ringCount) {
+    size_t end = sizeof(MapCacheHeader) + (size_t(ringCount) + 1) * sizeof(uint32_t);
+    return (end + 7) & ~size_t(7);
+}
+
+/**
+ * @brief Hash over the GeoJSON source and the normalization it is baked with.
+ * @param source Mapped source file, may be closed if the source is missing.
+ */
+uint64_t sourceHash(const MappedFile& source, const MapNorm& norm) {
+    uint64_t hash = fnv1a(source.data(), source.size());
+    return fnv1a(&norm, sizeof(norm), hash);
+}
+
+/**
+ * @brief Checks that a ring offset table describes rings inside the point array: it starts at 0, never
+ * decreases and ends at the point count.
+ */
+bool validOffsets(const uint32_t* offsets, uint32_t ringCount, uint32_t pointCount) {
+    if (offsets[0] != 0 || offsets[ringCount] != pointCount) return false;
+    for (uint32_t i = 0; i < ringCount; ++i) {
+        if (offsets[i + 1] < offsets[i]) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Load a map, preferring the baked binary cache next to the GeoJSON file.
+ * @param geojsonPath Path to the GeoJSON source file.
+ * @param norm Normalization parameters.
+ * @return Map polylines, empty on failure.
+ */
+PolylineSet loadMap(const std::string& geojsonPath, const MapNorm& norm) {
+    const std::string cachePath = geojsonPath + ".bin";
+
+    MappedFile source;
+    bool haveSource = source.open(geojsonPath);
+    uint64_t hash = haveSource ? sourceHash(source, norm) : 0;
+    source.close();
+
+    auto cache = std::make_shared<MappedFile>();
+    if (cache->open(cachePath) && cache->size() >= sizeof(MapCacheHeader)) {
+        MapCacheHeader header;
+        std::memcpy(&header, cache->data(), sizeof(header));
+        size_t ptsOffset = pointsOffset(header.ringCount);
+        bool valid = std::memcmp(header.magic, MAP_CACHE_MAGIC, sizeof(MAP_CACHE_MAGIC)) == 0 &&
+                     header.version == MAP_CACHE_VERSION &&
+                     std::memcmp(&header.norm, &norm, sizeof(norm)) == 0 &&
+                     cache->size() == ptsOffset + size_t(header.pointCount) * sizeof(glm::vec2);
+        // without the source there is nothing to compare against, trust the cache
+        if (valid && haveSource) valid = header.sourceHash == hash;
+        // the offsets index the points; a corrupt table would read past the mapping
+        const uint32_t* offsets = reinterpret_cast<const uint32_t*>(cache->data() + sizeof(MapCacheHeader));
+        if (valid) valid = validOffsets(offsets, header.ringCount, header.pointCount);
+
+        if (valid) {
+            const glm::vec2* points = reinterpret_cast<const glm::vec2*>(cache->data() + ptsOffset);
+            return PolylineSet::fromMemory(cache, points, header.pointCount, offsets, header.ringCount);
+        }
+        std::cerr << "Map cache is stale, rebuilding: " << cachePath << "\n";
+    }
+    cache.reset();
+
+    if (!haveSource) {
+        std::cerr << "Failed to load map: " << geojsonPath << "\n";
+        return PolylineSet();
+    }
+
+    PolylineSet map = loadMapFromGeoJSON(geojsonPath, norm);
+    if (!map.empty()) writeMapCache(cachePath, map, norm, hash);
+    return map;
+}
+
+/**
+ * @brief Write a baked map cache file.
+ *
+ * The file is written under a temporary name and renamed afterwards, so a concurrently starting
+ * instance never maps a half-written cache.
+ *
+ * @param cachePath Destination path.
+ * @param map Normalized polylines.
+ * @param norm Normalization the polylines were built with.
+ * @param sourceHash Hash of the source, see MapCacheHeader::sourceHash.
+ * @return True on success, false otherwise.
+ */
+bool writeMapCache(const std::string& cachePath, const PolylineSet& map, const MapNorm& norm, uint64_t sourceHash) {
+    MapCacheHeader header;
+    std::memcpy(header.magic, MAP_CACHE_MAGIC, sizeof(header.magic));
+    header.version = MAP_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.norm = norm;
+    header.ringCount = static_cast<uint32_t>(map.ringCount());
+    header.pointCount = static_cast<uint32_t>(map.pointCount());
+
+    const std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to write map cache: " << cachePath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(map.ringOffsets()), (map.ringCount() + 1) * sizeof(uint32_t));
+
+        static const char padding[8] = {};
+        size_t written = sizeof(header) + (map.ringCount() + 1) * sizeof(uint32_t);
+        out.write(padding, pointsOffset(header.ringCount) - written);
+        out.write(reinterpret_cast<const char*>(map.points()), map.pointCount() * sizeof(glm::vec2));
+        if (!out) {
+            std::cerr << "Failed to write map cache: " << cachePath << "\n";
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(cachePath.c_str());  // rename does not replace existing files on Windows
+    if (std::rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to write map cache: " << cachePath << "\n";
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
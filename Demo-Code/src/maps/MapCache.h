@@ -0,0 +1,50 @@
+#ifndef MAPCACHE_H
+#define MAPCACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include "GeoJSONLoader.h"
+#include "PolylineSet.h"
+
+/**
+ * @brief Header of a baked map cache file.
+ *
+ * The header is followed by uint32_t ringOffsets[ringCount + 1], zero padding up to the next 8 byte
+ * boundary and glm::vec2 points[pointCount] holding the already normalized coordinates.
+ */
+struct MapCacheHeader {
+    char magic[4];        ///< Always "RTMC".
+    uint32_t version;     ///< MAP_CACHE_VERSION at bake time.
+    uint64_t sourceHash;  ///< FNV-1a hash over the GeoJSON source bytes and the normalization.
+    MapNorm norm;         ///< Normalization the points were baked with.
+    uint32_t ringCount;   ///< Number of rings.
+    uint32_t pointCount;  ///< Total number of points.
+};
+
+constexpr uint32_t MAP_CACHE_VERSION = 1;
+
+/**
+ * @brief Load a map, preferring the baked binary cache next to the GeoJSON file.
+ *
+ * The cache ("<geojsonPath>.bin") is memory-mapped and the returned set points straight into the
+ * mapping. If the cache is missing, has another version or was baked from a different source or
+ * normalization, the GeoJSON file is parsed and the cache is rebuilt for the next start.
+ *
+ * @param geojsonPath Path to the GeoJSON source file.
+ * @param norm Normalization parameters.
+ * @return Map polylines, empty on failure.
+ */
+PolylineSet loadMap(const std::string& geojsonPath, const MapNorm& norm);
+
+/**
+ * @brief Write a baked map cache file.
+ * @param cachePath Destination path.
+ * @param map Normalized polylines.
+ * @param norm Normalization the polylines were built with.
+ * @param sourceHash Hash of the source, see MapCacheHeader::sourceHash.
+ * @return True on success, false otherwise.
+ */
+bool writeMapCache(const std::string& cachePath, const PolylineSet& map, const MapNorm& norm, uint64_t sourceHash);
+
+#endif  // MAPCACHE_H
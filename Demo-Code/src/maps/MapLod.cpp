@@ -0,0 +1,104 @@
+#include "MapLod.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Squared distance of point p to the segment a-b.
+ */
+float segmentDistanceSq(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    glm::vec2 ab = b - a;
+    glm::vec2 ap = p - a;
+    float lenSq = ab.x * ab.x + ab.y * ab.y;
+    float t = lenSq > 0.0f ? std::min(std::max((ap.x * ab.x + ap.y * ab.y) / lenSq, 0.0f), 1.0f) : 0.0f;
+    glm::vec2 d = ap - ab * t;
+    return d.x * d.x + d.y * d.y;
+}
+
+/**
+ * @brief Douglas-Peucker simplification of one ring, appending the kept points to out.
+ * Iterative with an explicit stack so long rings cannot overflow the call stack.
+ */
+void simplifyRing(const glm::vec2* pts, size_t count, float toleranceSq, std::vector<glm::vec2>& out,
+                  std::vector<char>& keep, std::vector<std::pair<size_t, size_t>>& stack) {
+    keep.assign(count, 0);
+    keep[0] = keep[count - 1] = 1;
+    stack.clear();
+    stack.emplace_back(0, count - 1);
+
+    while (!stack.empty()) {
+        auto [first, last] = stack.back();
+        stack.pop_back();
+
+        float maxDistSq = 0.0f;
+        size_t index = first;
+        for (size_t i = first + 1; i < last; ++i) {
+            float distSq = segmentDistanceSq(pts[i], pts[first], pts[last]);
+            if (distSq > maxDistSq) {
+                maxDistSq = distSq;
+                index = i;
+            }
+        }
+        if (maxDistSq > toleranceSq) {
+            keep[index] = 1;
+            stack.emplace_back(first, index);
+            stack.emplace_back(index, last);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        if (keep[i]) out.push_back(pts[i]);
+}
+
+}  // namespace
+
+/**
+ * @brief Simplify every ring with the Douglas-Peucker algorithm.
+ * @param map Polylines to simplify.
+ * @param tolerance Maximum distance between the simplified and the original ring, in map units.
+ * @return Simplified polylines.
+ */
+PolylineSet simplifyPolylines(const PolylineSet& map, float tolerance) {
+    std::vector<glm::vec2> points;
+    std::vector<uint32_t> offsets;
+    std::vector<char> keep;
+    std::vector<std::pair<size_t, size_t>> stack;
+    points.reserve(map.pointCount());
+    offsets.reserve(map.ringCount() + 1);
+    offsets.push_back(0);
+
+    for (size_t ring = 0; ring < map.ringCount(); ++ring) {
+        const glm::vec2* pts = map.points() + map.ringBegin(ring);
+        size_t count = map.ringSize(ring);
+
+        const MapBounds& box = map.ringBounds(ring);
+        // degenerate and sub-tolerance rings stay as empty slots
+        if (count >= 2 && (box.max.x - box.min.x >= tolerance || box.max.y - box.min.y >= tolerance)) {
+            simplifyRing(pts, count, tolerance * tolerance, points, keep, stack);
+        }
+        offsets.push_back(static_cast<uint32_t>(points.size()));
+    }
+    points.shrink_to_fit();
+    return PolylineSet::fromArrays(std::move(points), std::move(offsets));
+}
+
+/**
+ * @brief Build the coarser levels of the LOD pyramid for a map.
+ * @param map Full resolution polylines.
+ * @return Simplified levels, finest first.
+ */
+std::vector<MapLod> buildMapLods(const PolylineSet& map) {
+    std::vector<MapLod> lods;
+    size_t previousCount = map.pointCount();
+    float tolerance = MAP_LOD_BASE_TOLERANCE;
+    for (int level = 0; level < MAP_LOD_MAX_LEVELS; ++level, tolerance *= 2.0f) {
+        PolylineSet simplified = simplifyPolylines(map, tolerance);
+        if (simplified.pointCount() == previousCount) continue;  // nothing gained over the finer level
+        previousCount = simplified.pointCount();
+        lods.push_back({tolerance, std::move(simplified)});
+        if (previousCount == 0) break;
+    }
+    return lods;
+}
@@ -0,0 +1,50 @@
+#ifndef MAPLOD_H
+#define MAPLOD_H
+
+#include <vector>
+
+#include "PolylineSet.h"
+
+/**
+ * @brief One simplified level of a map.
+ */
+struct MapLod {
+    float tolerance;  ///< Douglas-Peucker tolerance in normalized map units.
+    PolylineSet map;  ///< Simplified polylines.
+};
+
+/**
+ * @brief Simplify every ring with the Douglas-Peucker algorithm.
+ *
+ * Rings whose bounding box is smaller than the tolerance in both directions are emptied, they would not
+ * cover more than a pixel at the zoom the level is used for. Emptied rings keep their slot in the offset
+ * table, so ring i of every level corresponds to ring i of the source map.
+ *
+ * @param map Polylines to simplify.
+ * @param tolerance Maximum distance between the simplified and the original ring, in map units.
+ * @return Simplified polylines.
+ */
+PolylineSet simplifyPolylines(const PolylineSet& map, float tolerance);
+
+/**
+ * @brief Build the coarser levels of the LOD pyramid for a map.
+ *
+ * The tolerances double from level to level, starting at MAP_LOD_BASE_TOLERANCE. Levels that would not
+ * remove any further vertex are skipped. The full resolution map is not part of the result.
+ *
+ * @param map Full resolution polylines.
+ * @return Simplified levels, finest first.
+ */
+std::vector<MapLod> buildMapLods(const PolylineSet& map);
+
+/**
+ * @brief Tolerance of the finest simplified level, in normalized map units.
+ */
+constexpr float MAP_LOD_BASE_TOLERANCE = 0.0005f;
+
+/**
+ * @brief Number of simplified levels built per map at most.
+ */
+constexpr int MAP_LOD_MAX_LEVELS = 10;
+
+#endif  // MAPLOD_H
@@ -0,0 +1,61 @@
+#include "MapQuantization.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Snap a point to the nearest grid position.
+ * @param p Point in map units.
+ * @return Grid coordinates, clamped to the int16 range.
+ */
+QuantizedPoint MapQuantization::quantize(glm::vec2 p) const {
+    glm::vec2 q = (p - center) / step;
+    auto snap = [](float v) { return static_cast<int16_t>(std::clamp(std::lround(v), -32767L, 32767L)); };
+    return QuantizedPoint{snap(q.x), snap(q.y)};
+}
+
+/**
+ * @brief Fit the quantization grid to the bounding box of a map.
+ * @param map Polylines.
+ * @return Grid parameters.
+ */
+MapQuantization computeQuantization(const PolylineSet& map) {
+    MapQuantization quantization;
+    if (map.pointCount() == 0) return quantization;
+
+    glm::vec2 lo = map.bounds().min, hi = map.bounds().max;
+    quantization.center = (lo + hi) * 0.5f;
+    // half extent over 32767 steps; a flat axis still gets a nonzero step
+    glm::vec2 halfExtent = (hi - lo) * 0.5f;
+    quantization.step = glm::vec2(std::max(halfExtent.x, 1e-6f), std::max(halfExtent.y, 1e-6f)) / 32767.0f;
+    return quantization;
+}
+
+/**
+ * @brief Quantize points and append them to an array.
+ * @param points Points in map units.
+ * @param count Number of points.
+ * @param quantization Grid to use.
+ * @param out Receives the quantized points.
+ */
+void quantizePoints(const glm::vec2* points, size_t count, const MapQuantization& quantization,
+                    std::vector<QuantizedPoint>& out) {
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) out.push_back(quantization.quantize(points[i]));
+}
+
+/**
+ * @brief Largest distance between a point and its quantized position.
+ * @param map Polylines.
+ * @param quantization Grid to check.
+ * @return Error in map units.
+ */
+float maxQuantizationError(const PolylineSet& map, const MapQuantization& quantization) {
+    float maxError = 0.0f;
+    for (size_t i = 0; i < map.pointCount(); ++i) {
+        const glm::vec2& p = map.points()[i];
+        glm::vec2 d = quantization.dequantize(quantization.quantize(p)) - p;
+        maxError = std::max(maxError, std::sqrt(d.x * d.x + d.y * d.y));
+    }
+    return maxError;
+}
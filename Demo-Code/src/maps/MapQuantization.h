@@ -0,0 +1,57 @@
+#ifndef MAPQUANTIZATION_H
+#define MAPQUANTIZATION_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "PolylineSet.h"
+
+/**
+ * @brief Map point stored as two signed 16-bit grid coordinates, 4 bytes instead of 8.
+ */
+struct QuantizedPoint {
+    int16_t x, y;
+};
+
+/**
+ * @brief Uniform grid over the bounding box of a map, used to store its points as QuantizedPoint.
+ *
+ * The grid is centered on the box and spans it with 65535 steps per axis, so a point is off by at most
+ * half a step in each direction. The vertex shader undoes the mapping with center + q * step.
+ */
+struct MapQuantization {
+    glm::vec2 center{0.0f};  ///< Middle of the bounding box, in map units.
+    glm::vec2 step{1.0f};    ///< Map units per grid step on each axis.
+
+    QuantizedPoint quantize(glm::vec2 p) const;
+    glm::vec2 dequantize(QuantizedPoint q) const { return center + glm::vec2(q.x, q.y) * step; }
+};
+
+/**
+ * @brief Fit the quantization grid to the bounding box of a map.
+ * Simplified levels only drop points, so the grid of the full resolution map covers all of its levels.
+ * @param map Polylines.
+ * @return Grid parameters.
+ */
+MapQuantization computeQuantization(const PolylineSet& map);
+
+/**
+ * @brief Quantize points and append them to an array.
+ * @param points Points in map units.
+ * @param count Number of points.
+ * @param quantization Grid to use.
+ * @param out Receives the quantized points.
+ */
+void quantizePoints(const glm::vec2* points, size_t count, const MapQuantization& quantization,
+                    std::vector<QuantizedPoint>& out);
+
+/**
+ * @brief Largest distance between a point and its quantized position.
+ * @param map Polylines.
+ * @param quantization Grid to check.
+ * @return Error in map units.
+ */
+float maxQuantizationError(const PolylineSet& map, const MapQuantization& quantization);
+
+#endif  // MAPQUANTIZATION_H
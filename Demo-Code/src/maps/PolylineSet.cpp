@@ -0,0 +1,104 @@
+#include "PolylineSet.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Build an owning set by flattening nested rings.
+ * @param rings Polylines as nested vectors.
+ * @return Set holding copies of all points.
+ */
+PolylineSet PolylineSet::fromRings(const std::vector<std::vector<glm::vec2>>& rings) {
+    PolylineSet set;
+    size_t total = 0;
+    for (const auto& ring : rings) total += ring.size();
+
+    set.ownedPoints.reserve(total);
+    set.ownedOffsets.reserve(rings.size() + 1);
+    set.ownedOffsets.push_back(0);
+    for (const auto& ring : rings) {
+        set.ownedPoints.insert(set.ownedPoints.end(), ring.begin(), ring.end());
+        set.ownedOffsets.push_back(static_cast<uint32_t>(set.ownedPoints.size()));
+    }
+
+    set.pts = set.ownedPoints.data();
+    set.offsets = set.ownedOffsets.data();
+    set.numPoints = set.ownedPoints.size();
+    set.rings = rings.size();
+    set.buildSideTables();
+    return set;
+}
+
+/**
+ * @brief Build an owning set from flat arrays.
+ * @param points Point array.
+ * @param offsets Ring offset table, one entry more than there are rings, starting with 0.
+ * @return Set taking ownership of both arrays.
+ */
+PolylineSet PolylineSet::fromArrays(std::vector<glm::vec2> points, std::vector<uint32_t> offsets) {
+    PolylineSet set;
+    set.ownedPoints = std::move(points);
+    set.ownedOffsets = std::move(offsets);
+    if (set.ownedOffsets.empty()) set.ownedOffsets.push_back(0);
+
+    set.pts = set.ownedPoints.data();
+    set.offsets = set.ownedOffsets.data();
+    set.numPoints = set.ownedPoints.size();
+    set.rings = set.ownedOffsets.size() - 1;
+    set.buildSideTables();
+    return set;
+}
+
+/**
+ * @brief Build a set that borrows its arrays from external memory.
+ * @param backing Object owning the memory; kept alive as long as the set.
+ * @param points Point array with pointCount entries.
+ * @param pointCount Number of points.
+ * @param offsets Ring offset table with ringCount + 1 entries.
+ * @param ringCount Number of rings.
+ * @return Set referencing the given memory without copying it.
+ */
+PolylineSet PolylineSet::fromMemory(std::shared_ptr<const void> backing, const glm::vec2* points, size_t pointCount,
+                                    const uint32_t* offsets, size_t ringCount) {
+    PolylineSet set;
+    set.backing = std::move(backing);
+    set.pts = points;
+    set.offsets = offsets;
+    set.numPoints = pointCount;
+    set.rings = ringCount;
+    set.buildSideTables();
+    return set;
+}
+
+/**
+ * @brief Inverted box that intersects nothing and grows to the first point added to it.
+ */
+MapBounds PolylineSet::emptyBounds() {
+    const float inf = std::numeric_limits<float>::infinity();
+    return MapBounds{glm::vec2(inf, inf), glm::vec2(-inf, -inf)};
+}
+
+/**
+ * @brief Fill the ring bounding box and centroid tables and the total extent in one pass over the points.
+ */
+void PolylineSet::buildSideTables() {
+    boundsTable.assign(rings, emptyBounds());
+    centroidTable.assign(rings, glm::vec2(0.0f));
+    extent = emptyBounds();
+    for (size_t ring = 0; ring < rings; ++ring) {
+        uint32_t count = ringSize(ring);
+        if (count == 0) continue;
+        const glm::vec2* first = pts + ringBegin(ring);
+        MapBounds& box = boundsTable[ring];
+        glm::vec2 sum(0.0f);
+        for (uint32_t i = 0; i < count; ++i) {
+            const glm::vec2& p = first[i];
+            box.min = glm::vec2(std::min(box.min.x, p.x), std::min(box.min.y, p.y));
+            box.max = glm::vec2(std::max(box.max.x, p.x), std::max(box.max.y, p.y));
+            sum += p;
+        }
+        centroidTable[ring] = sum / float(count);
+        extent.min = glm::vec2(std::min(extent.min.x, box.min.x), std::min(extent.min.y, box.min.y));
+        extent.max = glm::vec2(std::max(extent.max.x, box.max.x), std::max(extent.max.y, box.max.y));
+    }
+}
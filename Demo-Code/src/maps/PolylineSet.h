@@ -0,0 +1,111 @@
+#ifndef POLYLINESET_H
+#define POLYLINESET_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Axis-aligned rectangle in normalized map units.
+ */
+struct MapBounds {
+    glm::vec2 min, max;
+
+    bool intersects(const MapBounds& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+    }
+    bool empty() const { return min.x > max.x || min.y > max.y; }
+};
+
+/**
+ * @brief Flat storage for map polylines: one contiguous point array plus a ring offset table.
+ *
+ * Ring i spans points()[ringOffsets()[i] .. ringOffsets()[i + 1]). The arrays are either owned by the
+ * set or borrowed from external memory (e.g. a memory-mapped map cache), in which case the set keeps
+ * the backing object alive. The layout can be uploaded to a VBO as-is.
+ *
+ * Every factory also fills two side tables, the bounding box and the centroid (mean of the points) of
+ * each ring, so culling, quantization and the highlight pulse do not walk the points again.
+ */
+class PolylineSet {
+   public:
+    PolylineSet() = default;
+
+    PolylineSet(PolylineSet&&) = default;
+    PolylineSet& operator=(PolylineSet&&) = default;
+    PolylineSet(const PolylineSet&) = delete;
+    PolylineSet& operator=(const PolylineSet&) = delete;
+
+    /**
+     * @brief Build an owning set by flattening nested rings.
+     */
+    static PolylineSet fromRings(const std::vector<std::vector<glm::vec2>>& rings);
+
+    /**
+     * @brief Build an owning set from flat arrays.
+     * @param points Point array.
+     * @param offsets Ring offset table, one entry more than there are rings, starting with 0.
+     */
+    static PolylineSet fromArrays(std::vector<glm::vec2> points, std::vector<uint32_t> offsets);
+
+    /**
+     * @brief Build a set that borrows its arrays from external memory.
+     * @param backing Object owning the memory; kept alive as long as the set.
+     * @param points Point array with pointCount entries.
+     * @param pointCount Number of points.
+     * @param offsets Ring offset table with ringCount + 1 entries.
+     * @param ringCount Number of rings.
+     */
+    static PolylineSet fromMemory(std::shared_ptr<const void> backing, const glm::vec2* points, size_t pointCount,
+                                  const uint32_t* offsets, size_t ringCount);
+
+    size_t ringCount() const { return rings; }
+    size_t pointCount() const { return numPoints; }
+    bool empty() const { return rings == 0; }
+
+    const glm::vec2* points() const { return pts; }
+    const uint32_t* ringOffsets() const { return offsets; }
+
+    uint32_t ringBegin(size_t ring) const { return offsets[ring]; }
+    uint32_t ringSize(size_t ring) const { return offsets[ring + 1] - offsets[ring]; }
+
+    /**
+     * @brief Bounding box of a ring; empty rings have an inverted box that intersects nothing.
+     */
+    const MapBounds& ringBounds(size_t ring) const { return boundsTable[ring]; }
+
+    /**
+     * @brief Mean of the points of a ring; the origin for empty rings.
+     */
+    glm::vec2 ringCentroid(size_t ring) const { return centroidTable[ring]; }
+
+    /**
+     * @brief Bounding box of all points.
+     */
+    const MapBounds& bounds() const { return extent; }
+
+    /**
+     * @brief Whether the arrays live in external (e.g. memory-mapped) memory.
+     */
+    bool isBorrowed() const { return backing != nullptr; }
+
+   private:
+    std::vector<glm::vec2> ownedPoints;
+    std::vector<uint32_t> ownedOffsets;
+    std::shared_ptr<const void> backing;
+
+    const glm::vec2* pts = nullptr;
+    const uint32_t* offsets = nullptr;
+    size_t numPoints = 0;
+    size_t rings = 0;
+
+    std::vector<MapBounds> boundsTable;
+    std::vector<glm::vec2> centroidTable;
+    MapBounds extent = emptyBounds();
+
+    static MapBounds emptyBounds();
+    void buildSideTables();
+};
+
+#endif  // POLYLINESET_H
@@ -0,0 +1,148 @@
+#include "RingIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief Position of (x, y) along a Hilbert curve over a 65536 x 65536 grid.
+ */
+uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        // rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+}  // namespace
+
+/**
+ * @brief Cut every ring into line strip pieces of at most maxPoints points.
+ * @param map Polylines.
+ * @param maxPoints Largest piece length, at least 2.
+ * @return Chunk ranges and boxes.
+ */
+MapChunks splitRings(const PolylineSet& map, uint32_t maxPoints) {
+    MapChunks chunks;
+    maxPoints = std::max(maxPoints, 2u);
+    for (size_t ring = 0; ring < map.ringCount(); ++ring) {
+        uint32_t begin = map.ringBegin(ring);
+        uint32_t size = map.ringSize(ring);
+        if (size < 2) continue;
+
+        for (uint32_t start = 0; start + 1 < size;) {
+            uint32_t end = std::min(start + maxPoints - 1, size - 1);
+            MapBounds box{map.points()[begin + start], map.points()[begin + start]};
+            for (uint32_t i = begin + start + 1; i <= begin + end; ++i) {
+                const glm::vec2& p = map.points()[i];
+                box.min = glm::vec2(std::min(box.min.x, p.x), std::min(box.min.y, p.y));
+                box.max = glm::vec2(std::max(box.max.x, p.x), std::max(box.max.y, p.y));
+            }
+            chunks.firsts.push_back(begin + start);
+            chunks.counts.push_back(end - start + 1);
+            chunks.bounds.push_back(box);
+            start = end;  // the next piece starts at the shared point
+        }
+    }
+    return chunks;
+}
+
+/**
+ * @brief Build the tree.
+ * @param ringBounds Bounding box per ring (or chunk), see PolylineSet::ringBounds().
+ */
+void RingIndex::build(const std::vector<MapBounds>& ringBounds) {
+    boxes.clear();
+    indices.clear();
+    levelEnds.clear();
+    numItems = ringBounds.size();
+    if (numItems == 0) return;
+
+    // total extent of all non-empty rings, used to quantize the centers onto the Hilbert grid
+    const float inf = std::numeric_limits<float>::infinity();
+    MapBounds extent{glm::vec2(inf, inf), glm::vec2(-inf, -inf)};
+    for (const auto& box : ringBounds) {
+        if (box.empty()) continue;
+        extent.min = glm::vec2(std::min(extent.min.x, box.min.x), std::min(extent.min.y, box.min.y));
+        extent.max = glm::vec2(std::max(extent.max.x, box.max.x), std::max(extent.max.y, box.max.y));
+    }
+    glm::vec2 size(std::max(extent.max.x - extent.min.x, 1e-6f), std::max(extent.max.y - extent.min.y, 1e-6f));
+
+    std::vector<uint64_t> keys(numItems, 0);
+    for (size_t i = 0; i < numItems; ++i) {
+        const MapBounds& box = ringBounds[i];
+        if (box.empty()) continue;
+        float cx = ((box.min.x + box.max.x) * 0.5f - extent.min.x) / size.x;
+        float cy = ((box.min.y + box.max.y) * 0.5f - extent.min.y) / size.y;
+        keys[i] = hilbertIndex(uint32_t(cx * 65535.0f), uint32_t(cy * 65535.0f));
+    }
+
+    std::vector<uint32_t> order(numItems);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    // leaves
+    for (uint32_t ring : order) {
+        boxes.push_back(ringBounds[ring]);
+        indices.push_back(ring);
+    }
+    levelEnds.push_back(boxes.size());
+
+    // pack NODE_SIZE consecutive nodes of each level into one parent until a single root remains
+    size_t levelStart = 0;
+    while (levelEnds.back() - levelStart > 1) {
+        size_t levelEnd = levelEnds.back();
+        for (size_t first = levelStart; first < levelEnd; first += NODE_SIZE) {
+            MapBounds node = boxes[first];
+            size_t last = std::min(first + NODE_SIZE, levelEnd);
+            for (size_t i = first + 1; i < last; ++i) {
+                node.min = glm::vec2(std::min(node.min.x, boxes[i].min.x), std::min(node.min.y, boxes[i].min.y));
+                node.max = glm::vec2(std::max(node.max.x, boxes[i].max.x), std::max(node.max.y, boxes[i].max.y));
+            }
+            boxes.push_back(node);
+            indices.push_back(static_cast<uint32_t>(first));
+        }
+        levelStart = levelEnd;
+        levelEnds.push_back(boxes.size());
+    }
+}
+
+/**
+ * @brief Collect all rings whose bounding box intersects the given rectangle.
+ * @param rect Query rectangle in map units.
+ * @param rings Receives the ring indices in Hilbert order; cleared first.
+ */
+void RingIndex::query(const MapBounds& rect, std::vector<uint32_t>& rings) const {
+    rings.clear();
+    if (boxes.empty()) return;
+
+    stack.clear();
+    stack.emplace_back(boxes.size() - 1, levelEnds.size() - 1);
+    while (!stack.empty()) {
+        auto [pos, level] = stack.back();
+        stack.pop_back();
+        if (!boxes[pos].intersects(rect)) continue;
+
+        if (level == 0) {
+            rings.push_back(indices[pos]);
+            continue;
+        }
+        size_t first = indices[pos];
+        size_t last = std::min(first + NODE_SIZE, levelEnds[level - 1]);
+        // push in reverse so children are visited (and leaves emitted) in Hilbert order
+        for (size_t child = last; child-- > first;) stack.emplace_back(child, level - 1);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef RINGINDEX_H
+#define RINGINDEX_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "PolylineSet.h"
+
+/**
+ * @brief Rings cut into pieces of bounded length, the unit of viewport culling.
+ * A few huge rings (e.g. the Saarland districts) would otherwise defeat culling at high zoom.
+ */
+struct MapChunks {
+    std::vector<uint32_t> firsts;    ///< First point of each chunk in the PolylineSet.
+    std::vector<uint32_t> counts;    ///< Point count of each chunk (at least 2).
+    std::vector<MapBounds> bounds;   ///< Bounding box of each chunk.
+};
+
+/**
+ * @brief Chunk length MapMesh cuts its rings into for culling; short enough that a zoomed in view skips
+ * most of a large ring, long enough to keep the index small.
+ */
+constexpr uint32_t MAP_CHUNK_POINTS = 64;
+
+/**
+ * @brief Cut every ring into line strip pieces of at most maxPoints points.
+ * Consecutive pieces share their boundary point, so drawing all of them reproduces the ring.
+ * Rings with fewer than two points are skipped.
+ * @param map Polylines.
+ * @param maxPoints Largest piece length, at least 2.
+ * @return Chunk ranges and boxes.
+ */
+MapChunks splitRings(const PolylineSet& map, uint32_t maxPoints);
+
+/**
+ * @brief Static packed R-tree over the bounding boxes of map rings (or ring chunks).
+ *
+ * The rings are sorted along a Hilbert curve and packed bottom-up into nodes of NODE_SIZE children,
+ * so the tree is a handful of flat arrays without per-node allocations. Built once when a map loads.
+ */
+class RingIndex {
+   public:
+    static constexpr uint32_t NODE_SIZE = 16;
+
+    /**
+     * @brief Build the tree.
+     * @param ringBounds Bounding box per ring (or chunk), see PolylineSet::ringBounds().
+     */
+    void build(const std::vector<MapBounds>& ringBounds);
+
+    /**
+     * @brief Collect all rings whose bounding box intersects the given rectangle.
+     * @param rect Query rectangle in map units.
+     * @param rings Receives the ring indices in Hilbert order; cleared first.
+     */
+    void query(const MapBounds& rect, std::vector<uint32_t>& rings) const;
+
+    size_t size() const { return numItems; }
+
+   private:
+    std::vector<MapBounds> boxes;      // Leaves first, then each upper level; the root is last.
+    std::vector<uint32_t> indices;     // Leaves: ring index. Inner nodes: position of the first child.
+    std::vector<size_t> levelEnds;     // End position of each level in boxes.
+    size_t numItems = 0;
+    mutable std::vector<std::pair<size_t, size_t>> stack;  // Query scratch: (position, level).
+};
+
+#endif  // RINGINDEX_H
@@ -1,7 +1,11 @@
 #include "LocateScene.h"
 
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <vector>
 
@@ -9,18 +13,9 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-#include <fstream>
-#include <sstream>
-
-#include "json.hpp"
-using json = nlohmann::json;
-
-/**
- * @brief Map normalization parameters for longitude and latitude.
- */
-struct MapNorm {
-    float lon_min, lon_max, lat_min, lat_max;
-};
+#include "core/Config.h"
+#include "core/Utf8.h"
+#include "maps/MapCache.h"
 
 // Germany and Saarland map normalization parameters
 const MapNorm norm_de = {5.0f, 16.0f, 47.0f, 55.0f};
@@ -28,64 +23,63 @@ const MapNorm norm_saar = {6.35f, 7.45f, 49.11f, 49.65f};
 const MapNorm norm_htw = {6.970, 6.978, 49.234, 49.242};
 
 /**
- * @brief Load map data from a GeoJSON file and normalize coordinates.
- * @param filename Path to the GeoJSON file.
- * @param norm Normalization parameters.
- * @return Vector of polylines (each polyline is a vector of glm::vec2 points).
+ * @brief Visible rectangle of an orthographic projection, in the units the projection maps from.
+ * @param projection Matrix built with glm::ortho.
+ * @return Left/bottom and right/top edges of the view.
  */
-std::vector<std::vector<glm::vec2>> loadMapFromGeoJSON(const std::string& filename, const MapNorm& norm) {
-    std::vector<std::vector<glm::vec2>> map;
-    std::ifstream infile(filename);
-    json j;
-    infile >> j;
-
-    for (const auto& feature : j["features"]) {
-        const auto& geom = feature["geometry"];
-        std::string type = geom["type"];
-        if (type == "Polygon") {
-            for (const auto& ring : geom["coordinates"]) {
-                std::vector<glm::vec2> poly;
-                for (const auto& pt : ring) {
-                    float x = (pt[0].get<float>() - norm.lon_min) / (norm.lon_max - norm.lon_min) * 2.0f - 1.0f;
-                    float y = (pt[1].get<float>() - norm.lat_min) / (norm.lat_max - norm.lat_min) * 2.0f - 1.0f;
-                    poly.emplace_back(x, y);
-                }
-                map.push_back(poly);
-            }
-        } else if (type == "MultiPolygon") {
-            for (const auto& polygon : geom["coordinates"]) {
-                for (const auto& ring : polygon) {
-                    std::vector<glm::vec2> poly;
-                    for (const auto& pt : ring) {
-                        float x = (pt[0].get<float>() - norm.lon_min) / (norm.lon_max - norm.lon_min) * 2.0f - 1.0f;
-                        float y = (pt[1].get<float>() - norm.lat_min) / (norm.lat_max - norm.lat_min) * 2.0f - 1.0f;
-                        poly.emplace_back(x, y);
-                    }
-                    map.push_back(poly);
-                }
-            }
-        } else if (type == "LineString") {
-            std::vector<glm::vec2> poly;
-            for (const auto& pt : geom["coordinates"]) {
-                float x = (pt[0].get<float>() - norm.lon_min) / (norm.lon_max - norm.lon_min) * 2.0f - 1.0f;
-                float y = (pt[1].get<float>() - norm.lat_min) / (norm.lat_max - norm.lat_min) * 2.0f - 1.0f;
-                poly.emplace_back(x, y);
-            }
-            map.push_back(poly);
-        }
-    }
-    return map;
+static MapBounds orthoViewBounds(const glm::mat4& projection) {
+    // glm::ortho: m[0][0] = 2 / (r - l), m[3][0] = -(r + l) / (r - l), same for y
+    glm::vec2 lo((-1.0f - projection[3][0]) / projection[0][0], (-1.0f - projection[3][1]) / projection[1][1]);
+    glm::vec2 hi((1.0f - projection[3][0]) / projection[0][0], (1.0f - projection[3][1]) / projection[1][1]);
+    return MapBounds{lo, hi};
 }
 
-// map data
-std::vector<std::vector<glm::vec2>> worldMap = {{}};
-std::vector<std::vector<glm::vec2>> germanyMap = {{}};
-std::vector<std::vector<glm::vec2>> saarMap = {{}};
-std::vector<std::vector<glm::vec2>> htwMap = {{}};
+/**
+ * @brief Map polylines and LOD pyramid prepared on a worker thread.
+ */
+struct LoadedMap {
+    PolylineSet map;
+    std::vector<MapLod> lods;
+    double loadMs = 0.0;  // Time spent in loadMap (cache hit or GeoJSON parse).
+    double lodMs = 0.0;   // Time spent building the LOD pyramid.
+};
 
-std::vector<std::vector<glm::vec2>> germanyMap_in_de_norm = {{}};
-std::vector<std::vector<glm::vec2>> saarMap_in_de_norm = {{}};
-std::vector<std::vector<glm::vec2>> saarbrücken_in_de_norm = {{}};
+/**
+ * @brief Start loading a map on its own thread. Only CPU work happens there; nothing touches GL.
+ * @param path GeoJSON file.
+ * @param norm Normalization of the map.
+ * @param withLods Also build the LOD pyramid.
+ * @return Future holding the loaded map and its timings.
+ */
+static std::future<LoadedMap> loadMapAsync(std::string path, MapNorm norm, bool withLods) {
+    return std::async(std::launch::async, [path = std::move(path), norm, withLods]() {
+        LoadedMap loaded;
+        auto t0 = std::chrono::steady_clock::now();
+        loaded.map = loadMap(path, norm);
+        auto t1 = std::chrono::steady_clock::now();
+        if (withLods) loaded.lods = buildMapLods(loaded.map);
+        auto t2 = std::chrono::steady_clock::now();
+        loaded.loadMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        loaded.lodMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        return loaded;
+    });
+}
+
+/**
+ * @brief Wait for a map started with loadMapAsync and log its timings.
+ * @param future Pending map.
+ * @param name Name used in the log.
+ * @return The loaded map.
+ */
+static LoadedMap collectMap(std::future<LoadedMap>& future, const char* name) {
+    LoadedMap loaded = future.get();
+    std::stringstream log;
+    log << "Map " << name << ": " << std::fixed << std::setprecision(2) << loaded.loadMs << " ms load";
+    if (!loaded.lods.empty()) log << ", " << loaded.lodMs << " ms LOD";
+    log << " (" << loaded.map.pointCount() << " points)";
+    std::cout << log.str() << std::endl;
+    return loaded;
+}
 
 /**
  * @brief Constructor. Initializes LocateScene and loads map data.
@@ -103,28 +97,97 @@ LocateScene::LocateScene()
       centerY(0.5f),
       targetCenterX(0.5f),
       targetCenterY(0.5f) {
-    steps = {"Locating: Earth", "Locating: Germany", "Locating: Saarbruecken", "Locating: HTW Saar"};
-    shaderProgram = ShaderManager::loadShader("shaders/line.vert", "shaders/line.frag");
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    worldMap = loadMapFromGeoJSON("assets/maps/world.geo.json", norm_de);
-    germanyMap = loadMapFromGeoJSON("assets/maps/germany.geo.json", norm_de);
-    saarMap = loadMapFromGeoJSON("assets/maps/saarland.geo.json", norm_saar);
-    htwMap = loadMapFromGeoJSON("assets/maps/htwsaar.geo.json", norm_htw);
-
-    germanyMap_in_de_norm = loadMapFromGeoJSON("assets/maps/simpleGermany.geo.json", norm_de);
-    saarMap_in_de_norm = loadMapFromGeoJSON("assets/maps/simpleSaarland.geo.json", norm_de);
-    saarbrücken_in_de_norm = loadMapFromGeoJSON("assets/maps/saarbruecken.geo.json", norm_saar);
+    steps = {"Locating: Earth", "Locating: Germany", "Locating: Saarbrücken", "Locating: HTW Saar"};
+    if (!lineBatch.initialize()) std::cerr << "LocateScene: radar overlays disabled" << std::endl;
+    mapShaderProgram = ShaderManager::loadShader("shaders/map.vert", "shaders/line.frag");
+    mapProjectionLoc = glGetUniformLocation(mapShaderProgram, "projection");
+    mapColorLoc = glGetUniformLocation(mapShaderProgram, "uColor");
+    mapOffsetLoc = glGetUniformLocation(mapShaderProgram, "uOffset");
+    mapScaleLoc = glGetUniformLocation(mapShaderProgram, "uScale");
+    mapPulseLoc = glGetUniformLocation(mapShaderProgram, "uPulse");
+    mapQuantCenterLoc = glGetUniformLocation(mapShaderProgram, "uQuantCenter");
+    mapQuantStepLoc = glGetUniformLocation(mapShaderProgram, "uQuantStep");
+
+    // parse all maps in parallel; startup waits for the slowest file instead of the sum
+    auto startupBegin = std::chrono::steady_clock::now();
+    auto worldFuture = loadMapAsync("assets/maps/world.geo.json", norm_de, true);
+    auto germanyFuture = loadMapAsync("assets/maps/germany.geo.json", norm_de, true);
+    auto saarFuture = loadMapAsync("assets/maps/saarland.geo.json", norm_saar, true);
+    auto htwFuture = loadMapAsync("assets/maps/htwsaar.geo.json", norm_htw, true);
+    auto germanyHighlightFuture = loadMapAsync("assets/maps/simpleGermany.geo.json", norm_de, false);
+    auto saarHighlightFuture = loadMapAsync("assets/maps/simpleSaarland.geo.json", norm_de, false);
+    auto saarbrueckenHighlightFuture = loadMapAsync("assets/maps/saarbruecken.geo.json", norm_saar, false);
+
+    // GL uploads stay on this thread; the CPU copies are released once their mesh is uploaded
+    LoadedMap world = collectMap(worldFuture, "world");
+    uploadMap(worldMesh, world.map, world.lods, "world");
+    LoadedMap germany = collectMap(germanyFuture, "germany");
+    uploadMap(germanyMesh, germany.map, germany.lods, "germany");
+    LoadedMap saar = collectMap(saarFuture, "saarland");
+    uploadMap(saarMesh, saar.map, saar.lods, "saarland");
+    LoadedMap htw = collectMap(htwFuture, "htwsaar");
+    uploadMap(htwMesh, htw.map, htw.lods, "htwsaar");
+
+    // highlight outlines are small; full resolution plus ring centroids for the pulse
+    germanyHighlightMesh.upload(collectMap(germanyHighlightFuture, "simpleGermany").map, {}, true);
+    saarHighlightMesh.upload(collectMap(saarHighlightFuture, "simpleSaarland").map, {}, true);
+    saarbrueckenHighlightMesh.upload(collectMap(saarbrueckenHighlightFuture, "saarbruecken").map, {}, true);
+
+    std::cout << "LocateScene maps ready after "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count()
+              << " ms" << std::endl;
+}
+
+/**
+ * @brief Upload a map and its LOD pyramid and log the vertex count of every level.
+ * @param mesh Destination mesh.
+ * @param map Full resolution polylines.
+ * @param lods Simplified levels built by buildMapLods().
+ * @param name Name used in the log.
+ */
+void LocateScene::uploadMap(MapMesh& mesh, const PolylineSet& map, const std::vector<MapLod>& lods,
+                            const char* name) {
+    mesh.upload(map, lods);
+
+    std::stringstream levels;
+    levels << "Map " << name << " LOD vertices:";
+    for (size_t i = 0; i < mesh.getLevelCount(); ++i) {
+        levels << " [" << i << "] " << mesh.getLevelVertexCount(i) << " (tol " << mesh.getLevelTolerance(i) << ")";
+    }
+    const MapQuantization& quantization = mesh.getQuantization();
+    levels << ", int16 step " << quantization.step.x << " x " << quantization.step.y << ", max error "
+           << maxQuantizationError(map, quantization) << " map units";
+    std::cout << levels.str() << std::endl;
+}
+
+/**
+ * @brief Bind the map shader and set the uniforms shared by all map draws.
+ * @param mesh Mesh about to be drawn; provides the dequantization grid.
+ * @param projection Projection matrix.
+ * @param cx Center X.
+ * @param cy Center Y.
+ * @param scale Map scale.
+ * @param color Line color.
+ * @param pulseScale Scale of each ring about its centroid, 1 for plain maps.
+ */
+void LocateScene::useMapShader(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale,
+                               glm::vec4 color, float pulseScale) {
+    const MapQuantization& quantization = mesh.getQuantization();
+    glUseProgram(mapShaderProgram);
+    glUniformMatrix4fv(mapProjectionLoc, 1, GL_FALSE, &projection[0][0]);
+    glUniform4fv(mapColorLoc, 1, &color[0]);
+    glUniform2f(mapOffsetLoc, cx, cy);
+    glUniform1f(mapScaleLoc, scale);
+    glUniform1f(mapPulseLoc, pulseScale);
+    glUniform2f(mapQuantCenterLoc, quantization.center.x, quantization.center.y);
+    glUniform2f(mapQuantStepLoc, quantization.step.x, quantization.step.y);
 }
 
 /**
  * @brief Destructor. Releases OpenGL resources.
  */
 LocateScene::~LocateScene() {
-    glDeleteProgram(shaderProgram);
-    glDeleteVertexArrays(1, &vao);
-    glDeleteBuffers(1, &vbo);
+    glDeleteProgram(mapShaderProgram);
 }
 
 /**
@@ -142,7 +205,7 @@ void LocateScene::update(float deltaTime) {
     centerX += (targetCenterX - centerX) * lerpSpeed * deltaTime;
     centerY += (targetCenterY - centerY) * lerpSpeed * deltaTime;
     if (charIndex < (int)steps[currentStep].size() && charTimer > 0.1f) {
-        charIndex++;
+        charIndex = (int)nextUtf8(steps[currentStep], charIndex);
         charTimer = 0.0f;
     }
 
@@ -165,6 +228,7 @@ void LocateScene::update(float deltaTime) {
 
     // change map based on timer and character index
     if (timer > 8.0f && charIndex == (int)steps[currentStep].size() && mapAnimFinished) {
+        reportFrameStats();
         if (currentStep == 0) {
             currentStep = 1;
             targetZoom = 5.0f;
@@ -197,36 +261,38 @@ void LocateScene::update(float deltaTime) {
 
 /**
  * @brief Draw a map using the given projection and parameters.
- * @param mapData Map polylines.
+ * Chooses the coarsest LOD level whose error stays below Config::mapLodPixelError at the current zoom
+ * and skips all rings outside the visible part of the projection.
+ * @param mesh Static map mesh.
  * @param projection Projection matrix.
  * @param cx Center X.
  * @param cy Center Y.
  * @param scale Map scale.
  * @param color Line color.
  */
-void LocateScene::drawMap(const std::vector<std::vector<glm::vec2>>& mapData, const glm::mat4& projection,
-                                     float cx, float cy, float scale, glm::vec4 color) {
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform4fv(glGetUniformLocation(shaderProgram, "uColor"), 1, &color[0]);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    for (const auto& polyline : mapData) {
-        std::vector<float> verts;
-        for (const auto& pt : polyline) {
-            verts.push_back(cx + pt.x * scale);
-            verts.push_back(cy + pt.y * scale);
-        }
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-        glDrawArrays(GL_LINE_STRIP, 0, verts.size() / 2);
+void LocateScene::drawMap(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale,
+                          glm::vec4 color) {
+    // one map unit covers scale world units, one world unit covers zoom pixels
+    size_t level = mesh.selectLevel(scale * zoom, Config::mapLodPixelError);
+    if (&mesh != lastDrawnMesh || level != lastDrawnLevel) {
+        std::cout << "LocateScene step " << currentStep << ": map LOD " << level << " ("
+                  << mesh.getLevelVertexCount(level) << " vertices)" << std::endl;
+        lastDrawnMesh = &mesh;
+        lastDrawnLevel = level;
     }
+
+    useMapShader(mesh, projection, cx, cy, scale, color, 1.0f);
+
+    // visible rectangle in map units: invert the placement the shader applies
+    MapBounds view = orthoViewBounds(projection);
+    view.min = (view.min - glm::vec2(cx, cy)) / scale;
+    view.max = (view.max - glm::vec2(cx, cy)) / scale;
+    statVertices += mesh.drawVisible(level, view);
+    frameDrawCalls++;
 }
 
 /**
- * @brief Draw a circle at the given position.
+ * @brief Draw a circle at the given position. Queued in the line batch until the next flush.
  * @param cx Center X.
  * @param cy Center Y.
  * @param r Radius.
@@ -234,26 +300,11 @@ void LocateScene::drawMap(const std::vector<std::vector<glm::vec2>>& mapData, co
  * @param projection Projection matrix.
  */
 void LocateScene::drawCircle(float cx, float cy, float r, glm::vec4 color, const glm::mat4& projection) {
-    std::vector<float> verts;
-    int N = 128;
-    for (int i = 0; i < N; ++i) {
-        float angle = i / float(N) * 2 * M_PI;
-        verts.push_back(cx + cos(angle) * r);
-        verts.push_back(cy + sin(angle) * r);
-    }
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform4fv(glGetUniformLocation(shaderProgram, "uColor"), 1, &color[0]);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glDrawArrays(GL_LINE_LOOP, 0, N);
+    lineBatch.addCircle(glm::vec2(cx, cy), r, color, projection);
 }
 
 /**
- * @brief Draw a point at the given position.
+ * @brief Draw a point at the given position. Queued in the line batch until the next flush.
  * @param x X position.
  * @param y Y position.
  * @param size Point size.
@@ -261,21 +312,11 @@ void LocateScene::drawCircle(float cx, float cy, float r, glm::vec4 color, const
  * @param projection Projection matrix.
  */
 void LocateScene::drawPoint(float x, float y, float size, glm::vec4 color, const glm::mat4& projection) {
-    float verts[2] = {x, y};
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform4fv(glGetUniformLocation(shaderProgram, "uColor"), 1, &color[0]);
-    glPointSize(size);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glDrawArrays(GL_POINTS, 0, 1);
+    lineBatch.addPoint(glm::vec2(x, y), size, color, projection);
 }
 
 /**
- * @brief Draw a line between two points.
+ * @brief Draw a line between two points. Queued in the line batch until the next flush.
  * @param x1 Start X.
  * @param y1 Start Y.
  * @param x2 End X.
@@ -285,20 +326,11 @@ void LocateScene::drawPoint(float x, float y, float size, glm::vec4 color, const
  */
 void LocateScene::drawLine(float x1, float y1, float x2, float y2, glm::vec4 color,
                                       const glm::mat4& projection) {
-    float verts[4] = {x1, y1, x2, y2};
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform4fv(glGetUniformLocation(shaderProgram, "uColor"), 1, &color[0]);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glDrawArrays(GL_LINES, 0, 2);
+    lineBatch.addLine(glm::vec2(x1, y1), glm::vec2(x2, y2), color, projection);
 }
 
 /**
- * @brief Draw a cross at the given position.
+ * @brief Draw a cross at the given position. Queued in the line batch until the next flush.
  * @param x Center X.
  * @param y Center Y.
  * @param len Half length of cross arms.
@@ -306,13 +338,14 @@ void LocateScene::drawLine(float x1, float y1, float x2, float y2, glm::vec4 col
  * @param projection Projection matrix.
  */
 void LocateScene::drawCross(float x, float y, float len, glm::vec4 color, const glm::mat4& projection) {
-    drawLine(x - len, y, x + len, y, color, projection);
-    drawLine(x, y - len, x, y + len, color, projection);
+    lineBatch.addCross(glm::vec2(x, y), len, color, projection);
 }
 
 /**
- * @brief Draw a pulsing effect at the center of each map polyline.
- * @param mapData Map polylines.
+ * @brief Draw a highlight map with every ring scaled about its own centroid.
+ * The scaling happens in the vertex shader from the mesh's centroid attribute, so this is a single
+ * draw call without per-frame geometry work.
+ * @param mesh Highlight mesh uploaded with ring centroids.
  * @param projection Projection matrix.
  * @param cx Center X.
  * @param cy Center Y.
@@ -320,38 +353,11 @@ void LocateScene::drawCross(float x, float y, float len, glm::vec4 color, const
  * @param pulseScale Pulse scale factor.
  * @param color Pulse color.
  */
-void LocateScene::drawMapPulseCenter(const std::vector<std::vector<glm::vec2>>& mapData,
-                                                const glm::mat4& projection, float cx, float cy, float scale,
-                                                float pulseScale, glm::vec4 color) {
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform4fv(glGetUniformLocation(shaderProgram, "uColor"), 1, &color[0]);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    for (const auto& polyline : mapData) {
-        if (polyline.empty()) continue;
-        // calculate center of the polyline
-        float sumX = 0, sumY = 0;
-        for (const auto& pt : polyline) {
-            sumX += pt.x;
-            sumY += pt.y;
-        }
-        float centerX = sumX / polyline.size();
-        float centerY = sumY / polyline.size();
-
-        std::vector<float> verts;
-        for (const auto& pt : polyline) {
-            float px = centerX + (pt.x - centerX) * pulseScale;
-            float py = centerY + (pt.y - centerY) * pulseScale;
-            verts.push_back(cx + px * scale);
-            verts.push_back(cy + py * scale);
-        }
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-        glDrawArrays(GL_LINE_STRIP, 0, verts.size() / 2);
-    }
+void LocateScene::drawMapPulse(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale,
+                               float pulseScale, glm::vec4 color) {
+    useMapShader(mesh, projection, cx, cy, scale, color, pulseScale);
+    mesh.draw();
+    frameDrawCalls++;
 }
 
 /**
@@ -366,6 +372,9 @@ void LocateScene::drawMapPulseCenter(const std::vector<std::vector<glm::vec2>>&
  */
 void LocateScene::render(Font& font, float y, float lineSpacing, float time, const glm::vec3& color,
                                     int width, int height) {
+    auto frameStart = std::chrono::steady_clock::now();
+    frameDrawCalls = 0;
+
     // background
     glClearColor(0.02f, 0.13f, 0.04f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -378,29 +387,29 @@ void LocateScene::render(Font& font, float y, float lineSpacing, float time, con
     glm::mat4 projection = glm::ortho(cx - viewW / 2, cx + viewW / 2, cy - viewH / 2, cy + viewH / 2);
 
     // layered map rendering
-    const std::vector<std::vector<glm::vec2>>* currentMap = &worldMap;
+    const MapMesh* currentMap = &worldMesh;
     float mapScale = 0.5f;
     MapNorm norm = norm_de;
     bool showHighlight = false;
     glm::vec4 highlightColor = glm::vec4(0.9f, 0.2f, 0.2f, 1.0f);
 
     if (currentStep == 0) {
-        currentMap = &worldMap;
+        currentMap = &worldMesh;
         mapScale = height * 0.02f;
         norm = norm_de;
         showHighlight = true;
     } else if (currentStep == 1) {
-        currentMap = &germanyMap;
+        currentMap = &germanyMesh;
         mapScale = height * 0.08f; 
         norm = norm_de;
         showHighlight = true;
     } else if (currentStep == 2) {
-        currentMap = &saarMap;
+        currentMap = &saarMesh;
         mapScale = height * 0.04f;
         norm = norm_saar;
         showHighlight = true;
     } else if (currentStep == 3) {
-        currentMap = &htwMap;
+        currentMap = &htwMesh;
         mapScale = height * 0.02f; 
         norm = norm_htw;
     }
@@ -489,9 +498,9 @@ void LocateScene::render(Font& font, float y, float lineSpacing, float time, con
             float py = startY + (targetY - startY) * t;
 
             // targeting path line
-            glLineWidth(2.0f);
+            lineBatch.setLineWidth(2.0f);
             drawLine(startX, startY, px, py, glm::vec4(1.0f, 0.95f, 0.4f, 1.0f), projection);
-            glLineWidth(1.0f);
+            lineBatch.setLineWidth(1.0f);
 
             // targeting point
             float screenTargetX = (px - (cx - viewW / 2)) / viewW * width;
@@ -500,10 +509,13 @@ void LocateScene::render(Font& font, float y, float lineSpacing, float time, con
             drawCross(screenTargetX, screenTargetY, 32.0f, glm::vec4(1.0f, 0.2f, 0.2f, 1.0f), screenProjection);
             drawCircle(screenTargetX, screenTargetY, 24.0f + 8.0f * fabs(sin(time * 2)),
                        glm::vec4(1.0f, 0.2f, 0.2f, 1.0f), screenProjection);
-            glLineWidth(8.0f);
+            lineBatch.setLineWidth(8.0f);
             drawCircle(screenTargetX, screenTargetY, 4.0f + 1.0f * fabs(sin(time * 2)),
                        glm::vec4(1.0f, 0.95f, 0.4f, 1.0f), screenProjection);
-            glLineWidth(1.0f);
+            lineBatch.setLineWidth(1.0f);
+
+            // radar overlays go below the highlight and the HUD
+            frameDrawCalls += lineBatch.flush();
 
             // highlight the target area
             if (t >= 1.0f && showHighlight) {
@@ -513,12 +525,12 @@ void LocateScene::render(Font& font, float y, float lineSpacing, float time, con
 
                 glLineWidth(5.0f);
                 if (currentStep == 0) {
-                    drawMapPulseCenter(germanyMap_in_de_norm, projection, cx, cy, mapScale, pulseScale, highlightColor);
+                    drawMapPulse(germanyHighlightMesh, projection, cx, cy, mapScale, pulseScale, highlightColor);
                 } else if (currentStep == 1) {
-                    drawMapPulseCenter(saarMap_in_de_norm, projection, cx, cy, mapScale, pulseScale, highlightColor);
+                    drawMapPulse(saarHighlightMesh, projection, cx, cy, mapScale, pulseScale, highlightColor);
                 } else if (currentStep == 2) {
-                    drawMapPulseCenter(saarbrücken_in_de_norm, projection, cx, cy, mapScale, pulseScale,
-                                       highlightColor);
+                    drawMapPulse(saarbrueckenHighlightMesh, projection, cx, cy, mapScale, pulseScale,
+                                 highlightColor);
                 }
                 glLineWidth(1.0f);
             }
@@ -529,10 +541,36 @@ void LocateScene::render(Font& font, float y, float lineSpacing, float time, con
             hud << "COORD: " << std::fixed << std::setprecision(6) << lon << ", " << lat << "   SIGNAL: " << signal
                 << "%";
             font.renderText(hud.str(), cx - 180, cy + viewH / 2 - 40, 0.7f, glm::vec3(1.0f, 0.2f, 0.2f));
-            std::string msg = steps[currentStep].substr(0, charIndex);
-            font.renderText(msg, cx - 180, cy + viewH / 2 - 80, 1.0f, glm::vec3(0, 1, 0));
+            // the step text is laid out once, the font shader reveals the typed prefix
+            stepRun.update(font, steps[currentStep], 1.0f, glm::vec3(0, 1, 0));
+            stepRun.draw(font, cx - 180, cy + viewH / 2 - 80, size_t(charIndex));
         }
+        frameDrawCalls += lineBatch.flush();
+    }
+
+    statFrames++;
+    statDrawCalls += frameDrawCalls;
+    statCpuMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+}
+
+/**
+ * @brief Print the averaged per-frame statistics of the current step and reset them.
+ * Counts the draw calls issued by the map and radar helpers (text rendering is not included)
+ * and the CPU time spent in render().
+ */
+void LocateScene::reportFrameStats() {
+    if (statFrames > 0) {
+        std::stringstream stats;
+        stats << "LocateScene step " << currentStep << ": " << statFrames << " frames, " << std::fixed
+              << std::setprecision(1) << double(statDrawCalls) / statFrames << " draw calls/frame, "
+              << double(statVertices) / statFrames << " visible map vertices/frame, " << std::setprecision(3)
+              << statCpuMs / statFrames << " ms CPU/frame";
+        std::cout << stats.str() << std::endl;
     }
+    statFrames = 0;
+    statDrawCalls = 0;
+    statVertices = 0;
+    statCpuMs = 0.0;
 }
 
 /**
@@ -552,4 +590,8 @@ void LocateScene::reset() {
     targetCenterY = 0.5f;
     locateAnimTimer = 0.0f;
     locatingStarted = false;
+    statFrames = 0;
+    statDrawCalls = 0;
+    statVertices = 0;
+    statCpuMs = 0.0;
 }
\ No newline at end of file
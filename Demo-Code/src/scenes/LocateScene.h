@@ -8,6 +8,9 @@
 #include "graphics/Font.h"
 #include "graphics/ShaderManager.h"
 #include "audio/SoundManager.h"
+#include "graphics/LineBatch.h"
+#include "graphics/MapMesh.h"
+#include "maps/PolylineSet.h"
 
 class Font;
 class SoundManager;
@@ -66,8 +69,13 @@ class LocateScene {
     /**
      * @brief Draw a map using the given projection and parameters.
      */
-    void drawMap(const std::vector<std::vector<glm::vec2>>& mapData, const glm::mat4& projection, float cx, float cy,
-                 float scale, glm::vec4 color);
+    void drawMap(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale, glm::vec4 color);
+
+    /**
+     * @brief Bind the map shader and set the uniforms shared by all map draws.
+     */
+    void useMapShader(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale,
+                      glm::vec4 color, float pulseScale);
 
     /**
      * @brief Draw a circle at the given position.
@@ -90,10 +98,20 @@ class LocateScene {
     void drawCross(float x, float y, float len, glm::vec4 color, const glm::mat4& projection);
 
     /**
-     * @brief Draw a pulsing effect at the center of each map polyline.
+     * @brief Upload a map and its LOD pyramid and log the vertex count of every level.
+     */
+    void uploadMap(MapMesh& mesh, const PolylineSet& map, const std::vector<MapLod>& lods, const char* name);
+
+    /**
+     * @brief Print the averaged per-frame statistics of the current step and reset them.
+     */
+    void reportFrameStats();
+
+    /**
+     * @brief Draw a highlight map with every ring scaled about its own centroid.
      */
-    void drawMapPulseCenter(const std::vector<std::vector<glm::vec2>>& mapData, const glm::mat4& projection, float cx,
-                            float cy, float scale, float pulseScale, glm::vec4 color);
+    void drawMapPulse(const MapMesh& mesh, const glm::mat4& projection, float cx, float cy, float scale,
+                      float pulseScale, glm::vec4 color);
 
     int currentStep;                // Current step in the locating sequence.
     float timer;                    // Timer for step transitions.
@@ -101,6 +119,7 @@ class LocateScene {
     float charTimer;                // Timer for character animation.
     int charIndex;                  // Current character index for text animation.
     std::vector<std::string> steps; // Step descriptions.
+    TextRun stepRun;                // Laid out description of the current step.
 
     float zoom, targetZoom;         // Current and target zoom levels.
     float centerX, centerY, targetCenterX, targetCenterY; // Current and target map center positions.
@@ -109,8 +128,22 @@ class LocateScene {
     bool locatingStarted = false;   // Whether locating animation has started.
 
     // OpenGL resources
-    unsigned int vao, vbo;          // Vertex array and buffer objects.
-    unsigned int shaderProgram;     // Shader program for rendering.
+    LineBatch lineBatch;            // Radar lines, circles, crosses and points of the frame.
+    unsigned int mapShaderProgram;  // Shader program for the static map meshes.
+    int mapProjectionLoc, mapColorLoc, mapOffsetLoc, mapScaleLoc, mapPulseLoc; // Uniform locations of the map shader.
+    int mapQuantCenterLoc, mapQuantStepLoc;  // Dequantization uniforms of the map shader.
+
+    MapMesh worldMesh, germanyMesh, saarMesh, htwMesh; // Static GPU copies of the layered maps.
+    MapMesh germanyHighlightMesh, saarHighlightMesh, saarbrueckenHighlightMesh; // Pulsing target outlines.
+    const MapMesh* lastDrawnMesh = nullptr; // Mesh drawn in the previous frame, for LOD change logging.
+    size_t lastDrawnLevel = 0;      // LOD level drawn in the previous frame.
+
+    // Per-frame statistics, averaged over each locate step
+    int frameDrawCalls = 0;         // Draw calls issued in the current frame.
+    int statFrames = 0;             // Frames rendered in the current step.
+    long long statDrawCalls = 0;    // Draw calls summed over the current step.
+    long long statVertices = 0;     // Map vertices submitted, summed over the current step.
+    double statCpuMs = 0.0;         // CPU time of render() summed over the current step.
 
     SoundManager* soundManager;     // Pointer to sound manager for playing sounds.
 };
\ No newline at end of file
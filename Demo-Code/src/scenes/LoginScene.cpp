@@ -9,8 +9,6 @@ LoginScene::LoginScene()
     : stage(SHOW_USERNAME),
       username("htw saar"),
       password("********"),
-      typedUsername(""),
-      typedPassword(""),
       timer(0.0f),
       charIndex(0),
       verifyingDots(0.0f),
@@ -26,7 +24,7 @@ void LoginScene::update(float deltaTime) {
     switch(stage) {
         case SHOW_USERNAME:
             if (charIndex < (int)username.length() && timer > 0.18f) {
-                typedUsername += username[charIndex++];
+                charIndex++;
                 timer = 0.0f;
                 if (onTypeCallback) {
                     onTypeCallback(); // Play typing sound
@@ -46,7 +44,7 @@ void LoginScene::update(float deltaTime) {
             break;
         case SHOW_PASSWORD:
             if (charIndex < (int)password.length() && timer > 0.18f) {
-                typedPassword += password[charIndex++];
+                charIndex++;
                 timer = 0.0f;
                 if (onTypeCallback) {
                     onTypeCallback(); // Play typing sound
@@ -91,48 +89,50 @@ void LoginScene::render(Font& font, float y, float lineSpacing, float time, cons
 
     float startY = y;
 
-    // LOGIN label (zentriert)
-    std::string loginLabel = "LOGIN:";
-    float loginX = (font.getScreenWidth() - font.getTextWidth(loginLabel, 1.0f)) / 2.0f;
-    font.renderText(loginLabel, loginX, startY, 1.0f, color);
+    // LOGIN label (zentriert); text runs are only laid out again when their text changes
+    loginRun.update(font, "LOGIN:", 1.0f, color);
+    float loginX = (font.getScreenWidth() - loginRun.getWidth()) / 2.0f;
+    loginRun.draw(font, loginX, startY);
 
     // Username-Zeile (Label an festem Platz, Animation rechts daneben)
+    // The typed prefix and the cursor are revealed by the font shader, the text is laid out once
     float unameY = startY - lineSpacing;
-    std::string unameLabel = "Username: ";
-    std::string unameAnim = (stage == SHOW_USERNAME) ? typedUsername + (promptCursor ? "_" : "") : username;
-    float unameLabelWidth = font.getTextWidth(unameLabel, 1.0f);
-    float unameLabelX = (font.getScreenWidth() - unameLabelWidth - 112) / 2.0f;
-    font.renderText(unameLabel, unameLabelX, unameY, 1.0f, color);
+    bool typingUsername = stage == SHOW_USERNAME;
+    unameLabelRun.update(font, "Username: ", 1.0f, color);
+    unameRun.update(font, username, 1.0f, color, true);
+    float unameLabelX = (font.getScreenWidth() - unameLabelRun.getWidth() - 112) / 2.0f;
+    unameLabelRun.draw(font, unameLabelX, unameY);
     // Animierter Text immer direkt rechts daneben
-    font.renderText(unameAnim, unameLabelX + unameLabelWidth, unameY, 1.0f, color);
+    unameRun.draw(font, unameLabelX + unameLabelRun.getWidth(), unameY,
+                  typingUsername ? size_t(charIndex) : std::string::npos, typingUsername && promptCursor);
 
     // Password-Zeile (Label an festem Platz, Animation rechts daneben)
     float pwdY = unameY - lineSpacing;
-    std::string pwdLabel = "Password: ";
-    std::string pwdAnim;
+    size_t pwdVisible = 0;
     if (stage == SHOW_PASSWORD) {
-        pwdAnim = typedPassword + (promptCursor ? "_" : "");
+        pwdVisible = size_t(charIndex);
     } else if (stage > SHOW_PASSWORD) {
-        pwdAnim = password;
+        pwdVisible = std::string::npos;
     }
-    float pwdLabelWidth = font.getTextWidth(pwdLabel, 1.0f);
-    float pwdLabelX = (font.getScreenWidth() - pwdLabelWidth - 112) / 2.0f;
-    font.renderText(pwdLabel, pwdLabelX, pwdY, 1.0f, color);
-    font.renderText(pwdAnim, pwdLabelX + pwdLabelWidth, pwdY, 1.0f, color);
+    pwdLabelRun.update(font, "Password: ", 1.0f, color);
+    pwdRun.update(font, password, 1.0f, color, true);
+    float pwdLabelX = (font.getScreenWidth() - pwdLabelRun.getWidth() - 112) / 2.0f;
+    pwdLabelRun.draw(font, pwdLabelX, pwdY);
+    pwdRun.draw(font, pwdLabelX + pwdLabelRun.getWidth(), pwdY, pwdVisible, stage == SHOW_PASSWORD && promptCursor);
 
-    // Verifying-Animation (wie gehabt)
+    // Verifying-Animation (wie gehabt), centered on the text with all three dots
     if (stage == VERIFYING) {
-        int dots = int(verifyingDots) % 4;
-        std::string verifying = "Verifying" + std::string(dots, '.');
-        float verifyingX = (font.getScreenWidth() - font.getTextWidth(verifying, 1.0f)) / 2.0f;
-        font.renderText(verifying, verifyingX, pwdY - lineSpacing, 1.0f, color);
+        const size_t dots = size_t(verifyingDots) % 4;
+        statusRun.update(font, "Verifying...", 1.0f, color);
+        float verifyingX = (font.getScreenWidth() - statusRun.getWidth()) / 2.0f;
+        statusRun.draw(font, verifyingX, pwdY - lineSpacing, sizeof("Verifying") - 1 + dots);
     }
 
     // ACCESS GRANTED (wie gehabt)
     if (stage == ACCESS_GRANTED || stage == FINISHED) {
-        std::string granted = "ACCESS GRANTED";
-        float grantedX = (font.getScreenWidth() - font.getTextWidth(granted, 1.2f)) / 2.0f;
-        font.renderText(granted, grantedX, pwdY - 2 * lineSpacing + 12.0f, 1.2f, glm::vec3(0.0f, 1.0f, 0.0f));
+        statusRun.update(font, "ACCESS GRANTED", 1.2f, glm::vec3(0.0f, 1.0f, 0.0f));
+        float grantedX = (font.getScreenWidth() - statusRun.getWidth()) / 2.0f;
+        statusRun.draw(font, grantedX, pwdY - 2 * lineSpacing + 12.0f);
     }
 }
 
@@ -143,8 +143,6 @@ void LoginScene::reset() {
     stage = SHOW_USERNAME;
     username = "htw saar";
     password = "********";
-    typedUsername.clear();
-    typedPassword.clear();
     timer = 0.0f;
     charIndex = 0;
     verifyingDots = 0.0f;
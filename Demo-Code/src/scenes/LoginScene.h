@@ -59,10 +59,12 @@ public:
 private:
     Stage stage;                      // Current stage of the login process.
     std::string username, password;   // Username and password strings.
-    std::string typedUsername, typedPassword; // Animated username and password.
     float timer;                      // Timer for animation.
-    int charIndex;                    // Current character index for typing animation.
+    int charIndex;                    // Characters of the username or password typed so far.
     float verifyingDots;              // Animation for verifying dots.
     float accessTimer;                // Timer for access granted stage.
     std::function<void()> onTypeCallback; // Callback for typing event.
+    TextRun loginRun, unameLabelRun, unameRun;  // Laid out login and username lines.
+    TextRun pwdLabelRun, pwdRun;                // Laid out password line.
+    TextRun statusRun;                          // Verifying or access granted message.
 };
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "TerminalScene.h"
 
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/Utf8.h"
+
 /**
  * @brief Constructor for TerminalScene class.
  * Initializes the animation text, displayed text, and other member variables.
@@ -19,6 +24,10 @@ TerminalScene::TerminalScene() :
     demoStarted(false),                                             // Flag to indicate if the demo has started, used to control when the code demo animation begins
     demoStartTime(0.0) {                                            // Start time for the demo, used to control the timing of the code demo animation
     fileTypingStartTime = -1.0f;                                    // Initialize file typing start time to -1, indicating no typing animation has started yet
+    displayedTextDirectory += animationTextDirectory;               // Whole lines are laid out once, the typed part is revealed by the font shader
+    displayedTextFile += animationTextFile;
+    grid.setScrollbackLines(SCROLLBACK_LINES);                      // Lines that run past the bottom scroll into a bounded history
+    sessionTerminal.getGrid().setScrollbackLines(SCROLLBACK_LINES);
     initializeDemos();                                              // Initialize the code demos with predefined code and output
 }
 
@@ -29,7 +38,6 @@ void TerminalScene::update(float currentTime) {
     this->currentTime = currentTime; // Update the current time for the animation
     // Update directory typing animation
     if (animationIndex < animationTextDirectory.size() && currentTime - animationLastTime >= 0.1) {     // Check if enough time has passed to type the next character
-        displayedTextDirectory += animationTextDirectory[animationIndex];                               // Append the next character from the animation text to the displayed text
         animationIndex++;                                                                               // Increment the animation index to move to the next character
         animationLastTime = currentTime;                                                                // Update the last time the animation was updated
         if (onTypeCallback) {
@@ -46,7 +54,6 @@ void TerminalScene::update(float currentTime) {
         fileTypingStartTime >= 0.0f &&
         currentTime - fileTypingStartTime >= 1.0f &&
         currentTime - animationLastTime >= 0.1) {
-        displayedTextFile += animationTextFile[animationIndexFile];                                     // Append the next character from the file animation text to the displayed text
         animationIndexFile++;                                                                           // Increment the file animation index to move to the next character 
         animationLastTime = currentTime;                                                                // Update the last time the animation was updated
         if (onTypeCallback) {
@@ -66,13 +73,26 @@ void TerminalScene::update(float currentTime) {
         demoStartTime = currentTime;
     }
 
+    // Replay the recorded session instead of the code demo; typed characters arrive as single character events
+    if (isSessionMode()) {
+        if (demoStarted && currentTime - demoStartTime > 0.5) {
+            session.advance(currentTime - demoStartTime - 0.5, sessionTerminal, [this](const std::string& data) {
+                if (onTypeCallback && !data.empty() && static_cast<unsigned char>(data[0]) >= 0x20 &&
+                    nextUtf8(data, 0) == data.size()) {
+                    onTypeCallback();
+                }
+            });
+        }
+        return;
+    }
+
     // Update code demo animation
     if (demoStarted && currentTime - demoStartTime > 0.5 && !demos.empty()) {
         const auto& codeLines = demos[0].code;
         if (codeLineIndex < codeLines.size()) {
             if (codeCharIndex < codeLines[codeLineIndex].size()) {
                 if (currentTime - lastCodeLineTime > 0.05) { // Typing speed per character
-                    codeCharIndex++;
+                    codeCharIndex = nextUtf8(codeLines[codeLineIndex], codeCharIndex);
                     lastCodeLineTime = currentTime;
                     if (onTypeCallback) {
                         onTypeCallback();
@@ -94,63 +114,75 @@ void TerminalScene::update(float currentTime) {
  * @param lineSpacing The spacing between lines of text.
  * @param currentTime The current time in seconds, used for timing animations.
  * @param textColor The color of the text to render.
+ * @param width Screen width.
+ * @param height Screen height.
  * This function renders the initial prompt, directory typing animation, file typing animation, and demo code output in the terminal style.
+ * In grid mode (the default) the screen goes through a cell grid drawn with one instanced call, see renderGrid().
  */
-void TerminalScene::render(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor) {
-    // Render directory typing animation (jetzt an oberster Stelle)
-    std::string dirLine = displayedTextDirectory;
-    if (animationIndex < animationTextDirectory.size()) {
-        // Blink every ~0.5 seconds
-        if (static_cast<int>(currentTime * 8) % 2 == 0) {
-            dirLine += "_"; // Show cursor while typing (blinking)
-        }
+void TerminalScene::render(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor,
+                           int width, int height) {
+    if (gridMode && !gridReady) {
+        gridReady = gridRenderer.initialize() && sessionRenderer.initialize();
+        gridMode = gridReady;  // fall back to text runs
+    }
+    if (gridMode) {
+        renderGrid(font, y, lineSpacing, currentTime, textColor, width, height);
+        return;
     }
-    font.renderText(dirLine, 10.0f, y, 1.0f, textColor);
+
+    // Render directory typing animation (jetzt an oberster Stelle)
+    // The lines are laid out whole once; the typed prefix and the cursor are revealed by the font shader
+    size_t dirVisible = displayedTextDirectory.size() - animationTextDirectory.size() + animationIndex;
+    // Show cursor while typing, blinking every ~0.5 seconds
+    bool dirCursor = animationIndex < animationTextDirectory.size() && static_cast<int>(currentTime * 8) % 2 == 0;
+    dirRun.update(font, displayedTextDirectory, 1.0f, textColor, true);
+    dirRun.draw(font, 10.0f, y, dirVisible, dirCursor);
 
     // Render file typing animation
     if (animationIndex >= animationTextDirectory.size()) {
-        std::string fileLine = displayedTextFile;
+        size_t fileVisible = displayedTextFile.size() - animationTextFile.size() + animationIndexFile;
         // Make the prompt cursor blink while typing
-        if (animationIndexFile < animationTextFile.size()) {
-            if (static_cast<int>(currentTime * 8) % 2 == 0) {
-                fileLine += "_";
-            }
-        }
-        font.renderText(fileLine, 10.0f, y - lineSpacing, 1.0f, textColor);
+        bool fileCursor = animationIndexFile < animationTextFile.size() && static_cast<int>(currentTime * 8) % 2 == 0;
+        fileRun.update(font, displayedTextFile, 1.0f, textColor, true);
+        fileRun.draw(font, 10.0f, y - lineSpacing, fileVisible, fileCursor);
     }
 
     // Render demo code, one character at a time
     if (demoStarted && currentTime - demoStartTime > 0.5) {
         float code_y = y - 4 * lineSpacing;
         if (!demos.empty()) {
-            font.renderText("Demo:", 10.0f, code_y, 1.0f, textColor);
+            demoLabelRun.update(font, "Demo:", 1.0f, textColor);
+            demoLabelRun.draw(font, 10.0f, code_y);
             code_y -= lineSpacing;
 
-            // Render code lines, one character at a time
+            // Code lines are laid out once and redrawn from their text runs
+            codeRuns.resize(demos[0].code.size());
             for (size_t i = 0; i < codeLineIndex && i < demos[0].code.size(); ++i) {
-                font.renderText(demos[0].code[i], 30.0f, code_y, 1.0f, textColor);
+                codeRuns[i].update(font, demos[0].code[i], 1.0f, textColor, true);
+                codeRuns[i].draw(font, 30.0f, code_y);
                 code_y -= lineSpacing;
             }
 
             // Render current line, one character at a time, with blinking cursor
             if (codeLineIndex < demos[0].code.size()) {
                 const std::string& line = demos[0].code[codeLineIndex];
-                std::string toRender = line.substr(0, codeCharIndex);
-                // Add blinking cursor if still typing this line
-                if (codeCharIndex < line.size() && static_cast<int>(currentTime * 2) % 2 == 0) {
-                    toRender += "_";
-                }
-                font.renderText(toRender, 30.0f, code_y, 1.0f, textColor);
+                // Show blinking cursor if still typing this line
+                bool cursor = codeCharIndex < line.size() && static_cast<int>(currentTime * 2) % 2 == 0;
+                codeRuns[codeLineIndex].update(font, line, 1.0f, textColor, true);
+                codeRuns[codeLineIndex].draw(font, 30.0f, code_y, codeCharIndex, cursor);
                 code_y -= lineSpacing;
             }
 
             // If all code lines are fully rendered, show output
             if (codeLineIndex >= demos[0].code.size()) {
                 code_y -= lineSpacing / 2;
-                font.renderText("Output:", 10.0f, code_y, 1.0f, textColor);
+                outputLabelRun.update(font, "Output:", 1.0f, textColor);
+                outputLabelRun.draw(font, 10.0f, code_y);
                 code_y -= lineSpacing;
-                for (const auto& outLine : demos[0].output) {
-                    font.renderText(outLine, 30.0f, code_y, 1.0f, textColor);
+                outputRuns.resize(demos[0].output.size());
+                for (size_t i = 0; i < demos[0].output.size(); ++i) {
+                    outputRuns[i].update(font, demos[0].output[i], 1.0f, textColor);
+                    outputRuns[i].draw(font, 30.0f, code_y);
                     code_y -= lineSpacing;
                 }
                 if (!finished && currentTime - lastCodeLineTime > 1.0f) {
@@ -161,6 +193,129 @@ void TerminalScene::render(Font& font, float y, float lineSpacing, float current
     }
 }
 
+/**
+ * @brief Renders the terminal through the cell grid: the same screen as render(), written into fixed
+ * columns and rows.
+ * Every frame writes the whole screen into the grid, but only cells whose content changed (the typed
+ * character, the blinking cursor) are uploaded, and the grid is drawn with one instanced call.
+ * Rows are a line spacing apart and columns the advance of the monospace font; the code lines are
+ * indented by whole cells and the gap before the output is a full row.
+ * A loaded session is drawn from its own terminal grid in place of the code demo, four rows down, with the
+ * terminal cursor blinking in the scene grid underneath.
+ * Once the lines run past the bottom row the grid scrolls: its top rows move into the scrollback ring and
+ * the view eases up by one row over SCROLL_SPEED through the renderer's scroll offset, without rewriting
+ * or uploading the rows that moved.
+ * @param font The font to use for rendering text.
+ * @param y The vertical position of the first row's baseline.
+ * @param lineSpacing The spacing between lines of text.
+ * @param currentTime The current time in seconds, used for timing animations.
+ * @param textColor The color of the text to render.
+ * @param width Screen width.
+ * @param height Screen height.
+ */
+void TerminalScene::renderGrid(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor,
+                               int width, int height) {
+    const float left = 10.0f;
+    const Character* cellGlyph = font.getGlyph('M');
+    if (!cellGlyph || lineSpacing <= 0.0f) return;
+    const glm::vec2 cellSize(cellGlyph->advance * font.getPixelScale(), lineSpacing);
+    const int columns = std::max(1, int((width - left) / cellSize.x));
+    const int rows = std::max(1, int(y / cellSize.y) + 1);
+    if (columns != grid.getColumns() || rows != grid.getRows()) grid.resize(columns, rows);
+
+    const uint32_t color = CellGrid::packColor(textColor);
+    const int indent = std::max(1, int(20.0f / cellSize.x + 0.5f));  // code is drawn 20 px further right
+    int row = 0;  // line of the output; lines before grid.getScrolledLines() are in the scrollback
+    // Scrolls the grid if the line is below the bottom row and returns its screen row
+    auto screenRow = [&]() {
+        int screen = row - int(grid.getScrolledLines());
+        if (screen >= rows) {
+            grid.scrollUp(screen - rows + 1, 0, rows, true);
+            screen = rows - 1;
+        }
+        return screen;
+    };
+    // Writes the typed prefix of a line, the cursor if shown, and blanks the rest of the row
+    auto line = [&](int column, const std::string& text, size_t visible, bool cursor) {
+        int screen = screenRow();
+        grid.clearRow(screen, 0, column);
+        column = grid.print(column, screen, text, color, visible);
+        if (cursor) grid.set(column++, screen, '_', color);
+        grid.clearRow(screen, column);
+        ++row;
+    };
+    auto blank = [&]() {
+        grid.clearRow(screenRow());
+        ++row;
+    };
+
+    bool dirTyping = animationIndex < animationTextDirectory.size();
+    line(0, displayedTextDirectory, displayedTextDirectory.size() - animationTextDirectory.size() + animationIndex,
+         dirTyping && static_cast<int>(currentTime * 8) % 2 == 0);
+    if (!dirTyping) {
+        bool fileTyping = animationIndexFile < animationTextFile.size();
+        line(0, displayedTextFile, displayedTextFile.size() - animationTextFile.size() + animationIndexFile,
+             fileTyping && static_cast<int>(currentTime * 8) % 2 == 0);
+    } else {
+        blank();
+    }
+    blank();
+    blank();
+
+    const bool sessionShown = isSessionMode() && demoStarted && currentTime - demoStartTime > 0.5;
+    if (isSessionMode()) {
+        sessionTerminal.setDefaultColor(color);
+    } else if (demoStarted && currentTime - demoStartTime > 0.5 && !demos.empty()) {
+        const CodeDemo& demo = demos[0];
+        line(0, "Demo:", std::string::npos, false);
+        for (size_t i = 0; i <= codeLineIndex && i < demo.code.size(); ++i) {
+            bool typing = i == codeLineIndex && codeCharIndex < demo.code[i].size();
+            line(indent, demo.code[i], i < codeLineIndex ? std::string::npos : codeCharIndex,
+                 typing && static_cast<int>(currentTime * 2) % 2 == 0);
+        }
+        if (codeLineIndex >= demo.code.size()) {
+            blank();
+            line(0, "Output:", std::string::npos, false);
+            for (const auto& outLine : demo.output) line(indent, outLine, std::string::npos, false);
+            if (!finished && currentTime - lastCodeLineTime > 1.0f) {
+                finished = true;
+            }
+        }
+    }
+    while (row - int(grid.getScrolledLines()) < rows) blank();
+
+    const float elapsed = std::max(currentTime - lastRenderTime, 0.0f);
+    lastRenderTime = currentTime;
+    followScroll(grid, gridScrolledLines, gridScroll, elapsed);
+    followScroll(sessionTerminal.getGrid(), sessionScrolledLines, sessionScroll, elapsed);
+    if (sessionShown && sessionScroll == 0.0f && sessionTerminal.isCursorVisible() &&
+        static_cast<int>(currentTime * 2) % 2 == 0) {
+        grid.set(sessionTerminal.getCursorColumn(), 4 + sessionTerminal.getCursorRow(), '_', color);
+    }
+
+    glm::mat4 projection = glm::ortho(0.0f, float(width), 0.0f, float(height));
+    gridRenderer.draw(grid, font, projection, glm::vec2(left, y), cellSize, gridScroll);
+    if (sessionShown) {
+        sessionRenderer.draw(sessionTerminal.getGrid(), font, projection, glm::vec2(left, y - 4 * lineSpacing),
+                             cellSize, sessionScroll);
+    }
+}
+
+/**
+ * @brief Eases the view of a grid after it scrolled: the view starts one row back in the history, where
+ * the lines were before, and moves down to the screen at SCROLL_SPEED rows per second.
+ * @param grid Grid drawn.
+ * @param seenLines Scrolled line count of the grid at the last call; updated.
+ * @param offset Scroll offset of the view in rows; updated.
+ * @param elapsed Seconds since the last call.
+ */
+void TerminalScene::followScroll(const CellGrid& grid, uint64_t& seenLines, float& offset, float elapsed) {
+    const uint64_t scrolled = grid.getScrolledLines();
+    if (scrolled > seenLines) offset = std::min(offset + float(scrolled - seenLines), 1.0f);
+    seenLines = scrolled;  // also after a resize started the count over
+    offset = std::max(offset - elapsed * SCROLL_SPEED, 0.0f);
+}
+
 /**
  * @brief Resets the terminal animation to its initial state.
  * This function clears the displayed text, resets animation indices, and sets the demo state to not started.
@@ -169,8 +324,8 @@ void TerminalScene::render(Font& font, float y, float lineSpacing, float current
  * Currently not in use
  */
 void TerminalScene::reset() {
-    displayedTextDirectory = "user@retroterminal:~$ ";
-    displayedTextFile = "user@retroterminal:~RetroTerminal$ ";
+    displayedTextDirectory = "user@retroterminal:~$ " + animationTextDirectory;
+    displayedTextFile = "user@retroterminal:~RetroTerminal$ " + animationTextFile;
     animationIndex = 0;
     animationIndexFile = 0;
     animationLastTime = 0.0;
@@ -181,6 +336,22 @@ void TerminalScene::reset() {
     demoStartTime = 0.0;
     finished = false;
     fileTypingStartTime = -1.0f;
+    grid.resize(grid.getColumns(), grid.getRows());  // drops the scrollback
+    gridScroll = sessionScroll = 0.0f;
+    if (session.isOpen()) loadSession(sessionPath);
+}
+
+/**
+ * @brief Loads a recorded terminal session (an asciinema cast file) to replay in grid mode instead of the
+ * built-in code demo. It starts where the demo would, half a second after the prompt lines are typed.
+ * @param path Path to the .cast file.
+ * @return False if the file could not be opened; the code demo is shown then.
+ */
+bool TerminalScene::loadSession(const std::string& path) {
+    sessionPath = path;
+    if (!session.open(path)) return false;
+    sessionTerminal.resize(session.getWidth(), session.getHeight());
+    return true;
 }
 
 
@@ -193,16 +364,20 @@ void TerminalScene::initializeDemos() {
         {{"#include <iostream>",
           "",
           "int main() {",
-          "    std::cout << \"Projektarbeit: Einfuehrung in die Demoszene\" << std::endl;",
+          "    std::cout << \"Projektarbeit: Einführung in die Demoszene\" << std::endl;",
           "    std::cout << \"Teilnehmer: Christian Petry, Xudong Zhang\" << std::endl;",
           "    return 0;",
           "}"},
-         {"Projektarbeit: Einfuehrung in die Demoszene",
+         {"Projektarbeit: Einführung in die Demoszene",
           "Teilnehmer: Christian Petry, Xudong Zhang"}}
     };
 }
 
 bool TerminalScene::isFinished() const {
+    if (isSessionMode()) {
+        return demoStarted && session.isFinished() &&
+               currentTime - (demoStartTime + 0.5 + session.getLastEventTime()) > 2.0;
+    }
     return animationIndex >= animationTextDirectory.size() &&
            animationIndexFile >= animationTextFile.size() &&
            demoStarted && 
@@ -7,6 +7,10 @@
 #include <numeric> // For std::accumulate
 
 #include "graphics/Font.h"
+#include "graphics/CellGridRenderer.h"
+#include "terminal/CastPlayer.h"
+#include "terminal/CellGrid.h"
+#include "terminal/VtTerminal.h"
 #include "audio/SoundManager.h"
 
 /**
@@ -26,7 +30,10 @@ public:
     
     void setOnTypeCallback(std::function<void()> callback) { onTypeCallback = callback; }
     void update(float currentTime);
-    void render(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor);
+    void render(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor, int width,
+                int height);
+    void setGridMode(bool enabled) { gridMode = enabled; }
+    bool loadSession(const std::string& path);
     void reset();
     bool isFinished() const;
 
@@ -54,6 +61,35 @@ private:
     SoundManager soundManager;
     bool finished;
 
+    TextRun dirRun, fileRun;                  // Laid out prompt lines.
+    TextRun demoLabelRun, outputLabelRun;     // "Demo:" and "Output:".
+    std::vector<TextRun> codeRuns;            // Finished code lines.
+    std::vector<TextRun> outputRuns;          // Output lines.
+
+    bool gridMode = true;                     // Draw through the cell grid instead of text runs.
+    bool gridReady = false;                   // gridRenderer initialized (needs the GL context).
+    CellGrid grid;                            // Screen contents in grid mode.
+    CellGridRenderer gridRenderer;            // Draws grid with one instanced call.
+
+    std::string sessionPath;                  // Cast file replayed instead of the code demo, if any.
+    CastPlayer session;                       // Streams its events.
+    VtTerminal sessionTerminal;               // Screen the session writes to.
+    CellGridRenderer sessionRenderer;         // Draws its grid below the prompt lines.
+
+    bool isSessionMode() const { return gridMode && session.isOpen(); }
+
+    static constexpr int SCROLLBACK_LINES = 200;  // History lines kept by the grids; bounds their memory.
+    static constexpr float SCROLL_SPEED = 8.0f;   // Rows per second the view eases down after a scroll.
+    float gridScroll = 0.0f;                      // Scroll offsets of the views, in rows.
+    float sessionScroll = 0.0f;
+    uint64_t gridScrolledLines = 0;               // Scrolled line counts already followed.
+    uint64_t sessionScrolledLines = 0;
+    float lastRenderTime = 0.0f;
+
+    void renderGrid(Font& font, float y, float lineSpacing, float currentTime, const glm::vec3& textColor, int width,
+                    int height);
+
+    static void followScroll(const CellGrid& grid, uint64_t& seenLines, float& offset, float elapsed);
     void initializeDemos();
 
     mutable float currentTime = 0.0f;
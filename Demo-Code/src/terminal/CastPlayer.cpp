@@ -0,0 +1,135 @@
+#include "CastPlayer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * @brief Reads a terminal size field of the header.
+ * @param object Header object holding the field.
+ * @param key Field name.
+ * @param fallback Value if the field is missing.
+ * @param value Receives the value.
+ * @return False if the field is present but not an integer from 1 to CastPlayer::MAX_SIZE.
+ */
+static bool readSize(const json& object, const char* key, int fallback, int& value) {
+    if (!object.contains(key)) {
+        value = fallback;
+        return true;
+    }
+    if (!object[key].is_number_integer()) return false;
+    const int64_t size = object[key].get<int64_t>();  // wide enough that the range check sees the real value
+    if (size <= 0 || size > CastPlayer::MAX_SIZE) return false;
+    value = int(size);
+    return true;
+}
+
+/**
+ * @brief Opens a cast file and reads its header; the first event is read ahead.
+ * @param path Path to the .cast file.
+ * @return False if the file could not be opened or has no valid version 2 or 3 header.
+ */
+bool CastPlayer::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open cast file: " << path << std::endl;
+        return false;
+    }
+
+    json header = json::parse(std::getline(file, line) ? line : std::string(), nullptr, false);
+    if (!header.is_object() || !header.contains("version") || !header["version"].is_number_integer()) {
+        std::cerr << "Invalid cast header in: " << path << std::endl;
+        close();
+        return false;
+    }
+    version = header["version"].get<int>();
+    bool sizeValid;
+    if (version == 2) {
+        sizeValid = readSize(header, "width", 80, width) && readSize(header, "height", 24, height);
+    } else if (version == 3 && header.contains("term") && header["term"].is_object()) {
+        sizeValid = readSize(header["term"], "cols", 80, width) && readSize(header["term"], "rows", 24, height);
+    } else {
+        std::cerr << "Unsupported cast version " << version << " in: " << path << std::endl;
+        close();
+        return false;
+    }
+    if (!sizeValid) {
+        std::cerr << "Invalid terminal size in: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    readEvent();
+    return true;
+}
+
+/**
+ * @brief Closes the file; the player is finished afterwards.
+ */
+void CastPlayer::close() {
+    if (file.is_open()) file.close();
+    file.clear();
+    version = 0;
+    width = 80;
+    height = 24;
+    eventTime = lastEventTime = 0.0;
+    hasEvent = false;
+}
+
+/**
+ * @brief Plays all events up to a point in time.
+ * @param time Seconds since the start of the session.
+ * @param terminal Terminal receiving output and resizes.
+ * @param onOutput Optional callback for each output event played, e.g. for typing sounds.
+ * @return Number of events played.
+ */
+size_t CastPlayer::advance(double time, VtTerminal& terminal, const std::function<void(const std::string&)>& onOutput) {
+    size_t played = 0;
+    while (hasEvent && eventTime <= time) {
+        if (eventCode == "o") {
+            terminal.write(eventData);
+            if (onOutput) onOutput(eventData);
+        } else if (eventCode == "r") {
+            // "<columns>x<rows>"; strtoll saturates instead of overflowing, out of range sizes are ignored
+            char* end = nullptr;
+            const long long columns = std::strtoll(eventData.c_str(), &end, 10);
+            const long long rows = *end == 'x' ? std::strtoll(end + 1, nullptr, 10) : 0;
+            if (columns > 0 && columns <= MAX_SIZE && rows > 0 && rows <= MAX_SIZE) {
+                terminal.resize(int(columns), int(rows));
+            }
+        }
+        lastEventTime = eventTime;
+        ++played;
+        readEvent();
+    }
+    return played;
+}
+
+/**
+ * @brief Reads the next event line into eventTime, eventCode and eventData. Blank lines, comments (v3)
+ * and malformed lines are skipped.
+ * @return False at the end of the file.
+ */
+bool CastPlayer::readEvent() {
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        json event = json::parse(line, nullptr, false);
+        if (!event.is_array() || event.size() < 3 || !event[0].is_number() || !event[1].is_string() ||
+            !event[2].is_string()) {
+            continue;
+        }
+        double t = event[0].get<double>();
+        eventTime = version == 3 ? eventTime + t : t;
+        eventCode = event[1].get<std::string>();
+        eventData = event[2].get<std::string>();
+        hasEvent = true;
+        return true;
+    }
+    hasEvent = false;
+    return false;
+}
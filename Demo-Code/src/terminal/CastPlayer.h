@@ -0,0 +1,53 @@
+#ifndef CASTPLAYER_H
+#define CASTPLAYER_H
+
+#include <fstream>
+#include <functional>
+#include <string>
+
+#include "VtTerminal.h"
+
+/**
+ * @brief Replays a recorded terminal session from an asciinema cast file into a VtTerminal.
+ *
+ * A cast file is newline delimited JSON: a header object (format version 2 or 3, terminal size) followed
+ * by one event array [time, code, data] per line. The file is streamed: only the next event is held in
+ * memory, so sessions of any length play without loading them first. Output ("o") events are written to
+ * the terminal and resize ("r") events resize it; input, markers and other events are skipped. Terminal
+ * sizes above MAX_SIZE columns or rows are rejected, so a broken file cannot allocate a huge grid.
+ * Version 2 event times are absolute, version 3 times are relative to the previous event; both are
+ * turned into seconds since the start of the session.
+ *
+ * Implemented in CastPlayer.cpp.
+ */
+class CastPlayer {
+   public:
+    static constexpr int MAX_SIZE = 1000;  ///< Largest accepted number of columns or rows.
+
+    bool open(const std::string& path);
+    void close();
+
+    size_t advance(double time, VtTerminal& terminal, const std::function<void(const std::string&)>& onOutput = {});
+
+    bool isOpen() const { return file.is_open(); }
+    bool isFinished() const { return !hasEvent; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    double getLastEventTime() const { return lastEventTime; }
+
+   private:
+    std::ifstream file;
+    std::string line;  // Reused line buffer.
+    int version = 0;
+    int width = 80;
+    int height = 24;
+    double eventTime = 0.0;      // Time of the event held below, seconds since the start.
+    double lastEventTime = 0.0;  // Time of the last event played.
+    bool hasEvent = false;
+    std::string eventCode;
+    std::string eventData;
+
+    bool readEvent();
+};
+
+#endif  // CASTPLAYER_H
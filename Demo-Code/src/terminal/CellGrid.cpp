@@ -0,0 +1,227 @@
+#include "CellGrid.h"
+
+#include <algorithm>
+
+#include "core/Utf8.h"
+
+/**
+ * @brief Constructor. Creates a blank grid.
+ * @param columns Number of columns.
+ * @param rows Number of rows.
+ * @param scrollbackLines History lines kept when the screen scrolls up.
+ */
+CellGrid::CellGrid(int columns, int rows, int scrollbackLines)
+    : columns(0), rows(0), scrollbackLines(std::max(scrollbackLines, 0)), capacity(1), firstRow(0), historyLines(0),
+      scrolledLines(0), changedBegin(0), changedEnd(0) {
+    resize(columns, rows);
+}
+
+/**
+ * @brief Changes the size; the grid is blank afterwards, the history is dropped and every cell counts as
+ * changed.
+ * @param columns Number of columns.
+ * @param rows Number of rows.
+ */
+void CellGrid::resize(int columns, int rows) {
+    this->columns = std::max(columns, 0);
+    this->rows = std::max(rows, 0);
+    capacity = std::max(this->rows + scrollbackLines, 1);
+    firstRow = 0;
+    historyLines = 0;
+    scrolledLines = 0;
+    cells.assign(size_t(this->columns) * capacity, Cell());
+    markAllChanged();
+}
+
+/**
+ * @brief Changes how many history lines are kept; like resize(), this blanks the grid.
+ * @param lines History lines.
+ */
+void CellGrid::setScrollbackLines(int lines) {
+    scrollbackLines = std::max(lines, 0);
+    resize(columns, rows);
+}
+
+/**
+ * @brief Blanks every cell of the screen; the history is kept.
+ */
+void CellGrid::clear() {
+    for (int row = 0; row < rows; ++row) clearRow(row);
+}
+
+/**
+ * @brief Drops the history lines; the screen is kept.
+ */
+void CellGrid::clearScrollback() {
+    for (int row = -historyLines; row < 0; ++row) blankRow(row);
+    historyLines = 0;
+}
+
+/**
+ * @brief Writes one cell. Positions outside the screen are ignored.
+ * @param column Column.
+ * @param row Row, 0 at the top.
+ * @param code Unicode code point.
+ * @param rgba Packed color.
+ * @return True if the cell changed.
+ */
+bool CellGrid::set(int column, int row, uint32_t code, uint32_t rgba) {
+    if (column < 0 || column >= columns || row < 0 || row >= rows) return false;
+    size_t index = size_t(getStorageRow(row)) * columns + column;
+    Cell& cell = cells[index];
+    if (cell.code == code && cell.rgba == rgba) return false;
+    cell.code = code;
+    cell.rgba = rgba;
+    markChanged(index, index + 1);
+    return true;
+}
+
+/**
+ * @brief Writes UTF-8 text into a row, one code point per cell, clipped at the right edge.
+ * @param column First column.
+ * @param row Row, 0 at the top.
+ * @param text UTF-8 text.
+ * @param rgba Packed color.
+ * @param bytes Only the code points starting within this many bytes are written, e.g. the typed prefix.
+ * @return Column after the last code point written.
+ */
+int CellGrid::print(int column, int row, const std::string& text, uint32_t rgba, size_t bytes) {
+    const size_t end = std::min(bytes, text.size());
+    for (size_t i = 0; i < end && column < columns;) {
+        set(column++, row, decodeUtf8(text, i), rgba);
+    }
+    return column;
+}
+
+/**
+ * @brief Blanks a range of cells in a row.
+ * @param row Row, 0 at the top.
+ * @param fromColumn First column to blank.
+ * @param toColumn Column after the last one to blank, clamped to the grid.
+ */
+void CellGrid::clearRow(int row, int fromColumn, int toColumn) {
+    toColumn = std::min(toColumn, columns);
+    for (int column = std::max(fromColumn, 0); column < toColumn; ++column) set(column, row, ' ', 0);
+}
+
+/**
+ * @brief Moves the rows of a region up, dropping its top rows and blanking its bottom ones.
+ * Scrolling the whole screen into the history advances the ring instead: the top rows become history and
+ * only the new bottom rows are written.
+ * @param lines Number of rows to scroll.
+ * @param top First row of the region.
+ * @param bottom Row after the last one of the region, clamped to the grid.
+ * @param toHistory Keep the rows leaving the top of the screen as history (text scrolling off, as by a line
+ *                  feed) rather than dropping them (lines deleted); only applies to the whole screen.
+ */
+void CellGrid::scrollUp(int lines, int top, int bottom, bool toHistory) {
+    top = std::max(top, 0);
+    bottom = std::min(bottom, rows);
+    if (lines <= 0 || top >= bottom) return;
+    lines = std::min(lines, bottom - top);
+    if (toHistory && top == 0 && bottom == rows) {
+        for (int i = 0; i < lines; ++i) {
+            firstRow = (firstRow + 1) % capacity;
+            blankRow(rows - 1);
+        }
+        historyLines = std::min(historyLines + lines, scrollbackLines);
+        scrolledLines += lines;
+        return;
+    }
+    moveRows(top + lines, top, bottom - top - lines);
+    for (int row = bottom - lines; row < bottom; ++row) blankRow(row);
+}
+
+/**
+ * @brief Moves the rows of a region down, dropping its bottom rows and blanking its top ones.
+ * @param lines Number of rows to scroll.
+ * @param top First row of the region.
+ * @param bottom Row after the last one of the region, clamped to the grid.
+ */
+void CellGrid::scrollDown(int lines, int top, int bottom) {
+    top = std::max(top, 0);
+    bottom = std::min(bottom, rows);
+    if (lines <= 0 || top >= bottom) return;
+    lines = std::min(lines, bottom - top);
+    moveRows(top, top + lines, bottom - top - lines);
+    for (int row = top; row < top + lines; ++row) blankRow(row);
+}
+
+/**
+ * @brief Forgets the recorded changes, typically after uploading them.
+ */
+void CellGrid::markUnchanged() {
+    changedBegin = 0;
+    changedEnd = 0;
+}
+
+/**
+ * @brief Records every storage cell as changed, e.g. when the glyphs they map to moved.
+ */
+void CellGrid::markAllChanged() {
+    changedBegin = 0;
+    changedEnd = cells.size();
+}
+
+/**
+ * @brief Packs a color into the RGBA8 layout of Cell::rgba (red in the lowest byte), alpha 255.
+ * @param color Color, components clamped to [0, 1].
+ */
+uint32_t CellGrid::packColor(const glm::vec3& color) {
+    glm::vec3 c8 = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return uint32_t(c8.x) | uint32_t(c8.y) << 8 | uint32_t(c8.z) << 16 | 0xFF000000u;
+}
+
+/**
+ * @brief Moves consecutive rows to another position, in runs that are contiguous in storage for both the
+ * source and the destination. The ranges may overlap.
+ * @param from First row to move.
+ * @param to Row it moves to.
+ * @param count Number of rows.
+ */
+void CellGrid::moveRows(int from, int to, int count) {
+    if (to < from) {
+        while (count > 0) {
+            const int source = getStorageRow(from), target = getStorageRow(to);
+            const int run = std::min({count, capacity - source, capacity - target});
+            const Cell* first = cells.data() + size_t(source) * columns;
+            std::move(first, first + size_t(run) * columns, cells.data() + size_t(target) * columns);
+            markChanged(size_t(target) * columns, size_t(target + run) * columns);
+            from += run;
+            to += run;
+            count -= run;
+        }
+    } else {
+        // back to front; source and target are the storage rows after the last ones of the run
+        while (count > 0) {
+            const int source = getStorageRow(from + count - 1) + 1, target = getStorageRow(to + count - 1) + 1;
+            const int run = std::min({count, source, target});
+            const Cell* last = cells.data() + size_t(source) * columns;
+            std::move_backward(last - size_t(run) * columns, last, cells.data() + size_t(target) * columns);
+            markChanged(size_t(target - run) * columns, size_t(target) * columns);
+            count -= run;
+        }
+    }
+}
+
+/**
+ * @brief Blanks a whole row, history rows included.
+ */
+void CellGrid::blankRow(int row) {
+    std::fill_n(storage(row), columns, Cell());
+    size_t begin = size_t(getStorageRow(row)) * columns;
+    markChanged(begin, begin + columns);
+}
+
+/**
+ * @brief Extends the changed range to cover [begin, end).
+ */
+void CellGrid::markChanged(size_t begin, size_t end) {
+    if (changedBegin >= changedEnd) {
+        changedBegin = begin;
+        changedEnd = end;
+    } else {
+        changedBegin = std::min(changedBegin, begin);
+        changedEnd = std::max(changedEnd, end);
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef CELLGRID_H
+#define CELLGRID_H
+
+#include <glm/glm.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One character cell of a terminal screen.
+ */
+struct Cell {
+    uint32_t code = ' ';  ///< Unicode code point.
+    uint32_t rgba = 0;    ///< Foreground color, packed with CellGrid::packColor().
+};
+
+/**
+ * @brief Fixed columns x rows screen of character cells with scrollback, the CPU side of a GPU terminal.
+ *
+ * Rows live in a ring of rows + scrollback lines storage rows. Scrolling the whole screen up into the
+ * history only advances the ring: the top row becomes history and the storage row after the bottom one is blanked and reused,
+ * so no cell moves and the oldest history line is overwritten once the ring is full. Memory stays at the
+ * capacity no matter how much is scrolled. Rows are addressed relative to the screen: 0 is the top row,
+ * -1 the most recent history line; getStorageRow() maps them into the ring, which is what data() and the
+ * change range index.
+ * Every write compares against the cell and only records a change if the content differs; the changes of
+ * a frame are kept as one range of storage cell indices, so a renderer uploads only the cells between the
+ * first and last change (see CellGridRenderer). Writing the same screen again every frame therefore costs
+ * no upload, and a scroll costs the one blanked row.
+ *
+ * Implemented in CellGrid.cpp.
+ */
+class CellGrid {
+   public:
+    CellGrid(int columns = 0, int rows = 0, int scrollbackLines = 0);
+
+    void resize(int columns, int rows);
+    void setScrollbackLines(int lines);
+    void clear();
+    void clearScrollback();
+
+    bool set(int column, int row, uint32_t code, uint32_t rgba);
+    int print(int column, int row, const std::string& text, uint32_t rgba, size_t bytes = std::string::npos);
+    void clearRow(int row, int fromColumn = 0, int toColumn = INT_MAX);
+    void scrollUp(int lines, int top = 0, int bottom = INT_MAX, bool toHistory = false);
+    void scrollDown(int lines, int top = 0, int bottom = INT_MAX);
+
+    /**
+     * @brief Cell at a column of a row; negative rows down to -getHistoryLines() are history.
+     */
+    const Cell& at(int column, int row) const { return cells[size_t(getStorageRow(row)) * columns + column]; }
+    const Cell* data() const { return cells.data(); }  ///< Storage rows, see getStorageRow().
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    int getCapacity() const { return capacity; }          ///< Storage rows: screen rows plus scrollback lines.
+    int getHistoryLines() const { return historyLines; }  ///< History lines currently kept above the screen.
+    uint64_t getScrolledLines() const { return scrolledLines; }  ///< Lines moved into history so far.
+    size_t size() const { return cells.size(); }                 ///< Storage cells.
+
+    /**
+     * @brief Storage row of a screen row; negative rows are history lines. Rows within one capacity of
+     * the screen wrap without a division.
+     */
+    int getStorageRow(int row) const {
+        int storageRow = firstRow + row;
+        if (storageRow >= capacity) return storageRow - capacity;
+        return storageRow < 0 ? storageRow + capacity : storageRow;
+    }
+
+    bool hasChanges() const { return changedBegin < changedEnd; }
+    size_t getChangedBegin() const { return changedBegin; }  ///< First changed cell index.
+    size_t getChangedEnd() const { return changedEnd; }      ///< One past the last changed cell index.
+    void markUnchanged();
+    void markAllChanged();
+
+    static uint32_t packColor(const glm::vec3& color);
+
+   private:
+    int columns, rows;
+    int scrollbackLines;      // History lines kept beyond the screen.
+    int capacity;             // rows + scrollbackLines, at least 1.
+    int firstRow;             // Storage row of screen row 0.
+    int historyLines;         // Valid history lines, at most scrollbackLines.
+    uint64_t scrolledLines;   // Lines moved into history since the last resize.
+    std::vector<Cell> cells;  // capacity storage rows, each columns cells.
+    size_t changedBegin;      // Range of storage cells changed since markUnchanged().
+    size_t changedEnd;
+
+    Cell* storage(int row) { return cells.data() + size_t(getStorageRow(row)) * columns; }
+    void moveRows(int from, int to, int count);
+    void blankRow(int row);
+    void markChanged(size_t begin, size_t end);
+};
+
+#endif  // CELLGRID_H
@@ -0,0 +1,499 @@
+#include "VtTerminal.h"
+
+#include <algorithm>
+
+#include "core/Utf8.h"
+
+/**
+ * @brief Constructor. Creates a blank terminal with the cursor in the top left corner.
+ * @param columns Number of columns.
+ * @param rows Number of rows.
+ */
+VtTerminal::VtTerminal(int columns, int rows) : grid(columns, rows), defaultColor(0xFFFFFFFFu) { reset(); }
+
+/**
+ * @brief Changes the size; the screen is cleared and the terminal reset.
+ * @param columns Number of columns.
+ * @param rows Number of rows.
+ */
+void VtTerminal::resize(int columns, int rows) {
+    grid.resize(columns, rows);
+    reset();
+}
+
+/**
+ * @brief Full reset (like ESC c): clears the screen and its history, homes the cursor and drops colors,
+ * scroll region and any half parsed sequence.
+ */
+void VtTerminal::reset() {
+    grid.clear();
+    grid.clearScrollback();
+    state = State::Ground;
+    cursorX = cursorY = 0;
+    wrapPending = false;
+    scrollTop = 0;
+    scrollBottom = grid.getRows();
+    savedX = savedY = 0;
+    color = savedColor = defaultColor;
+    colorIndex = -1;
+    bold = false;
+    cursorVisible = true;
+    paramCount = 0;
+    privateMarker = false;
+    utf8Code = 0;
+    utf8Minimum = 0;
+    utf8Remaining = 0;
+}
+
+/**
+ * @brief Sets the color of text printed without an SGR color, e.g. the green of the demo.
+ * @param rgba Packed color, see CellGrid::packColor().
+ */
+void VtTerminal::setDefaultColor(uint32_t rgba) {
+    if (color == defaultColor) color = rgba;
+    if (savedColor == defaultColor) savedColor = rgba;
+    defaultColor = rgba;
+}
+
+/**
+ * @brief Interprets a chunk of terminal output. Sequences may continue in the next chunk.
+ * @param data Output bytes, UTF-8 text with control and escape sequences.
+ * @param size Number of bytes.
+ */
+void VtTerminal::write(const char* data, size_t size) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    while (p < end) {
+        const unsigned char c = *p;
+        switch (state) {
+            case State::Ground:
+                if (utf8Remaining > 0) {
+                    if ((c & 0xC0) == 0x80) {
+                        utf8Code = (utf8Code << 6) | (c & 0x3F);
+                        ++p;
+                        if (--utf8Remaining == 0) {
+                            bool valid = utf8Code >= utf8Minimum && utf8Code <= 0x10FFFF &&
+                                         (utf8Code < 0xD800 || utf8Code > 0xDFFF);
+                            print(valid ? utf8Code : UTF8_REPLACEMENT);
+                        }
+                        continue;
+                    }
+                    utf8Remaining = 0;  // truncated sequence, c is handled below
+                    print(UTF8_REPLACEMENT);
+                }
+                if (c >= 0x20 && c < 0x7F) {
+                    // fast path: a run of printable ASCII
+                    const unsigned char* run = p;
+                    while (run < end && *run >= 0x20 && *run < 0x7F) ++run;
+                    for (; p < run; ++p) print(*p);
+                    continue;
+                }
+                ++p;
+                if (c == 0x1B) {
+                    state = State::Escape;
+                } else if (c < 0x20) {
+                    control(c);
+                } else if (c >= 0xC2 && c <= 0xDF) {
+                    utf8Code = c & 0x1F;
+                    utf8Minimum = 0x80;
+                    utf8Remaining = 1;
+                } else if (c >= 0xE0 && c <= 0xEF) {
+                    utf8Code = c & 0x0F;
+                    utf8Minimum = 0x800;
+                    utf8Remaining = 2;
+                } else if (c >= 0xF0 && c <= 0xF4) {
+                    utf8Code = c & 0x07;
+                    utf8Minimum = 0x10000;
+                    utf8Remaining = 3;
+                } else if (c != 0x7F) {
+                    print(UTF8_REPLACEMENT);  // stray continuation or invalid lead byte
+                }
+                break;
+
+            case State::Escape:
+                ++p;
+                if (c == '[') {
+                    state = State::Csi;
+                    paramCount = 0;
+                    params[0] = 0;
+                    privateMarker = false;
+                } else if (c == ']') {
+                    state = State::Osc;
+                } else if (c >= 0x20 && c <= 0x2F) {
+                    state = State::EscapeIntermediate;  // e.g. ESC ( B, character set selection
+                } else if (c == 0x1B) {
+                    // ESC ESC: the first one is dropped
+                } else if (c < 0x20) {
+                    control(c);
+                } else {
+                    escapeDispatch(c);
+                    state = State::Ground;
+                }
+                break;
+
+            case State::EscapeIntermediate:
+                ++p;
+                if (c >= 0x30 && c <= 0x7E) state = State::Ground;  // final byte, sequence ignored
+                else if (c == 0x1B) state = State::Escape;
+                else if (c < 0x20) control(c);
+                break;
+
+            case State::Csi:
+                ++p;
+                if (c >= '0' && c <= '9') {
+                    if (paramCount == 0) paramCount = 1;
+                    int& value = params[paramCount - 1];
+                    value = std::min(value * 10 + (c - '0'), 65535);
+                } else if (c == ';' || c == ':') {
+                    if (paramCount == 0) paramCount = 1;
+                    if (paramCount < MAX_PARAMS) params[paramCount++] = 0;
+                } else if (c >= 0x3C && c <= 0x3F) {
+                    privateMarker = true;
+                } else if (c >= 0x40 && c <= 0x7E) {
+                    csiDispatch(c);
+                    state = State::Ground;
+                } else if (c == 0x1B) {
+                    state = State::Escape;  // sequence aborted
+                } else if (c < 0x20) {
+                    control(c);  // C0 controls execute inside sequences
+                }
+                // intermediate bytes 0x20-0x2F are ignored
+                break;
+
+            case State::Osc:
+                ++p;
+                if (c == 0x07) state = State::Ground;
+                else if (c == 0x1B) state = State::OscEscape;
+                break;
+
+            case State::OscEscape:
+                // ESC \ ends the string; anything else ends it too
+                ++p;
+                state = State::Ground;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Puts a character at the cursor and advances it, wrapping at the right edge like a VT100: the
+ * cursor stays on the last column until the next character arrives.
+ */
+void VtTerminal::print(uint32_t code) {
+    if (wrapPending) {
+        cursorX = 0;
+        lineFeed();
+        wrapPending = false;
+    }
+    grid.set(cursorX, cursorY, code, color);
+    if (cursorX + 1 >= grid.getColumns()) {
+        wrapPending = true;
+    } else {
+        ++cursorX;
+    }
+}
+
+/**
+ * @brief Executes a C0 control character.
+ */
+void VtTerminal::control(unsigned char c) {
+    switch (c) {
+        case '\b':
+            if (cursorX > 0) --cursorX;
+            wrapPending = false;
+            break;
+        case '\t':
+            cursorX = std::min((cursorX / 8 + 1) * 8, std::max(grid.getColumns() - 1, 0));
+            wrapPending = false;
+            break;
+        case '\n':
+        case '\v':
+        case '\f':
+            lineFeed();
+            wrapPending = false;
+            break;
+        case '\r':
+            cursorX = 0;
+            wrapPending = false;
+            break;
+        default:
+            break;  // BEL, SO/SI and the rest are ignored
+    }
+}
+
+/**
+ * @brief Moves the cursor down a row, scrolling the scroll region at its bottom.
+ */
+void VtTerminal::lineFeed() {
+    if (cursorY == scrollBottom - 1) {
+        grid.scrollUp(1, scrollTop, scrollBottom, true);  // only text scrolled off by LF/index is history
+    } else if (cursorY < grid.getRows() - 1) {
+        ++cursorY;
+    }
+}
+
+/**
+ * @brief Moves the cursor up a row, scrolling the scroll region down at its top.
+ */
+void VtTerminal::reverseIndex() {
+    if (cursorY == scrollTop) {
+        grid.scrollDown(1, scrollTop, scrollBottom);
+    } else if (cursorY > 0) {
+        --cursorY;
+    }
+}
+
+/**
+ * @brief Executes an escape sequence without parameters (ESC followed by c).
+ */
+void VtTerminal::escapeDispatch(unsigned char c) {
+    switch (c) {
+        case '7':
+            savedX = cursorX;
+            savedY = cursorY;
+            savedColor = color;
+            break;
+        case '8':
+            moveCursor(savedX, savedY);
+            color = savedColor;
+            break;
+        case 'D':
+            lineFeed();
+            break;
+        case 'E':
+            cursorX = 0;
+            lineFeed();
+            break;
+        case 'M':
+            reverseIndex();
+            break;
+        case 'c':
+            reset();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Executes a complete CSI sequence.
+ * @param final Final byte, selecting the function.
+ */
+void VtTerminal::csiDispatch(unsigned char final) {
+    const int columns = grid.getColumns();
+    const int rows = grid.getRows();
+    if (privateMarker) {
+        // DEC private modes; only cursor visibility (?25) matters for the grid
+        if ((final == 'h' || final == 'l') && param(0, 0) == 25) cursorVisible = final == 'h';
+        return;
+    }
+
+    const int n = param(0, 1);
+    switch (final) {
+        case 'A':
+            moveCursor(cursorX, cursorY - n);
+            break;
+        case 'B':
+        case 'e':
+            moveCursor(cursorX, cursorY + n);
+            break;
+        case 'C':
+        case 'a':
+            moveCursor(cursorX + n, cursorY);
+            break;
+        case 'D':
+            moveCursor(cursorX - n, cursorY);
+            break;
+        case 'E':
+            moveCursor(0, cursorY + n);
+            break;
+        case 'F':
+            moveCursor(0, cursorY - n);
+            break;
+        case 'G':
+        case '`':
+            moveCursor(n - 1, cursorY);
+            break;
+        case 'H':
+        case 'f':
+            moveCursor(param(1, 1) - 1, n - 1);
+            break;
+        case 'd':
+            moveCursor(cursorX, n - 1);
+            break;
+        case 'J':
+            switch (param(0, 0)) {
+                case 0:
+                    grid.clearRow(cursorY, cursorX);
+                    for (int row = cursorY + 1; row < rows; ++row) grid.clearRow(row);
+                    break;
+                case 1:
+                    for (int row = 0; row < cursorY; ++row) grid.clearRow(row);
+                    grid.clearRow(cursorY, 0, cursorX + 1);
+                    break;
+                case 3:
+                    grid.clearScrollback();
+                    break;
+                default:
+                    grid.clear();
+                    break;
+            }
+            break;
+        case 'K':
+            switch (param(0, 0)) {
+                case 0:
+                    grid.clearRow(cursorY, cursorX);
+                    break;
+                case 1:
+                    grid.clearRow(cursorY, 0, cursorX + 1);
+                    break;
+                default:
+                    grid.clearRow(cursorY);
+                    break;
+            }
+            break;
+        case '@':
+            for (int column = columns - 1; column >= cursorX + n; --column) {
+                Cell cell = grid.at(column - n, cursorY);
+                grid.set(column, cursorY, cell.code, cell.rgba);
+            }
+            grid.clearRow(cursorY, cursorX, cursorX + n);
+            break;
+        case 'P':
+            for (int column = cursorX; column + n < columns; ++column) {
+                Cell cell = grid.at(column + n, cursorY);
+                grid.set(column, cursorY, cell.code, cell.rgba);
+            }
+            grid.clearRow(cursorY, std::max(columns - n, cursorX));
+            break;
+        case 'X':
+            grid.clearRow(cursorY, cursorX, cursorX + n);
+            break;
+        case 'L':
+            if (cursorY >= scrollTop && cursorY < scrollBottom) grid.scrollDown(n, cursorY, scrollBottom);
+            break;
+        case 'M':
+            if (cursorY >= scrollTop && cursorY < scrollBottom) grid.scrollUp(n, cursorY, scrollBottom);
+            break;
+        case 'S':
+            grid.scrollUp(n, scrollTop, scrollBottom);
+            break;
+        case 'T':
+            grid.scrollDown(n, scrollTop, scrollBottom);
+            break;
+        case 'r': {
+            int top = param(0, 1) - 1;
+            int bottom = std::min(param(1, rows), rows);
+            if (top >= 0 && top + 1 < bottom) {
+                scrollTop = top;
+                scrollBottom = bottom;
+                moveCursor(0, 0);
+            }
+            break;
+        }
+        case 's':
+            savedX = cursorX;
+            savedY = cursorY;
+            break;
+        case 'u':
+            moveCursor(savedX, savedY);
+            break;
+        case 'm':
+            selectGraphicRendition();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Applies an SGR (CSI ... m) sequence to the color of printed characters.
+ */
+void VtTerminal::selectGraphicRendition() {
+    if (paramCount == 0) paramCount = 1;  // CSI m is CSI 0 m
+    for (int i = 0; i < paramCount; ++i) {
+        const int p = params[i];
+        if (p == 0) {
+            color = defaultColor;
+            colorIndex = -1;
+            bold = false;
+        } else if (p == 1) {
+            bold = true;
+            if (colorIndex >= 0) color = paletteColor(colorIndex + 8);
+        } else if (p == 22) {
+            bold = false;
+            if (colorIndex >= 0) color = paletteColor(colorIndex);
+        } else if (p >= 30 && p <= 37) {
+            colorIndex = p - 30;
+            color = paletteColor(colorIndex + (bold ? 8 : 0));
+        } else if (p == 39) {
+            color = defaultColor;
+            colorIndex = -1;
+        } else if (p >= 90 && p <= 97) {
+            colorIndex = -1;
+            color = paletteColor(p - 90 + 8);
+        } else if (p == 38 || p == 48) {
+            // extended color: 5;index or 2;r;g;b, background ones are skipped
+            uint32_t extended = 0;
+            bool valid = false;
+            if (i + 2 < paramCount && params[i + 1] == 5) {
+                extended = paletteColor(std::min(params[i + 2], 255));
+                valid = true;
+                i += 2;
+            } else if (i + 4 < paramCount && params[i + 1] == 2) {
+                extended = uint32_t(std::min(params[i + 2], 255)) | uint32_t(std::min(params[i + 3], 255)) << 8 |
+                           uint32_t(std::min(params[i + 4], 255)) << 16 | 0xFF000000u;
+                valid = true;
+                i += 4;
+            }
+            if (valid && p == 38) {
+                color = extended;
+                colorIndex = -1;
+            }
+        }
+        // backgrounds, italic, underline, blink, inverse... are not drawn
+    }
+}
+
+/**
+ * @brief Moves the cursor, clamped to the screen, and cancels a pending wrap.
+ */
+void VtTerminal::moveCursor(int column, int row) {
+    cursorX = std::clamp(column, 0, std::max(grid.getColumns() - 1, 0));
+    cursorY = std::clamp(row, 0, std::max(grid.getRows() - 1, 0));
+    wrapPending = false;
+}
+
+/**
+ * @brief Numeric parameter of the current CSI sequence; missing and zero parameters give the fallback.
+ */
+int VtTerminal::param(int index, int fallback) const {
+    return index < paramCount && params[index] != 0 ? params[index] : fallback;
+}
+
+/**
+ * @brief Color of an xterm 256 color palette entry: 16 system colors, a 6x6x6 cube and 24 grays.
+ * @param index Palette index, 0 to 255.
+ * @return Packed color.
+ */
+uint32_t VtTerminal::paletteColor(int index) {
+    static const uint32_t system[16] = {
+        0x000000, 0xCD0000, 0x00CD00, 0xCDCD00, 0x0000EE, 0xCD00CD, 0x00CDCD, 0xE5E5E5,
+        0x7F7F7F, 0xFF0000, 0x00FF00, 0xFFFF00, 0x5C5CFF, 0xFF00FF, 0x00FFFF, 0xFFFFFF,
+    };
+    uint32_t r, g, b;
+    if (index < 16) {
+        r = system[index] >> 16 & 0xFF;
+        g = system[index] >> 8 & 0xFF;
+        b = system[index] & 0xFF;
+    } else if (index < 232) {
+        static const uint32_t levels[6] = {0, 95, 135, 175, 215, 255};
+        index -= 16;
+        r = levels[index / 36];
+        g = levels[index / 6 % 6];
+        b = levels[index % 6];
+    } else {
+        r = g = b = 8 + 10 * uint32_t(index - 232);
+    }
+    return r | g << 8 | b << 16 | 0xFF000000u;
+}
@@ -0,0 +1,87 @@
+#ifndef VTTERMINAL_H
+#define VTTERMINAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "CellGrid.h"
+
+/**
+ * @brief Terminal emulation core: interprets a VT100/ANSI byte stream into a CellGrid.
+ *
+ * The parser is a byte driven state machine after the DEC VT500 parser model (ground, escape, CSI and
+ * OSC states); input may be cut anywhere, including inside UTF-8 sequences and escape sequences, so
+ * output can be fed in whatever chunks it arrives. Runs of printable ASCII take a fast path straight
+ * into the grid. Supported:
+ * - C0 controls: BS, HT (stops every 8 columns), LF/VT/FF, CR; BEL and the rest are ignored.
+ * - ESC 7/8 (save/restore cursor), D (index), E (next line), M (reverse index), c (reset).
+ * - CSI A B C D E F G H f d (cursor moves), J K (erase display/line; 3J erases the history), @ P X
+ *   (insert/delete/erase characters), L M (insert/delete lines), S T (scroll), r (scroll region), s u
+ *   (save/restore), m (SGR: reset, bold, 8/16 colors, 256 colors and 24 bit colors, default color),
+ *   ?25 h/l (cursor).
+ * - OSC strings (window titles) are skipped.
+ * Lines that line feeds and index scroll off the top of the whole screen go to the scrollback of the grid,
+ * if it has one; deleted lines (DL) and scrolls by CSI S are dropped.
+ * Unknown sequences are consumed and ignored. Background colors and attributes other than bold are
+ * parsed but not drawn, since cells only carry a foreground color.
+ *
+ * Implemented in VtTerminal.cpp.
+ */
+class VtTerminal {
+   public:
+    VtTerminal(int columns = 80, int rows = 24);
+
+    void resize(int columns, int rows);
+    void reset();
+    void write(const char* data, size_t size);
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void setDefaultColor(uint32_t rgba);
+
+    CellGrid& getGrid() { return grid; }
+    const CellGrid& getGrid() const { return grid; }
+    int getCursorColumn() const { return cursorX; }
+    int getCursorRow() const { return cursorY; }
+    bool isCursorVisible() const { return cursorVisible; }
+
+   private:
+    enum class State { Ground, Escape, EscapeIntermediate, Csi, Osc, OscEscape };
+
+    static constexpr int MAX_PARAMS = 16;
+
+    CellGrid grid;
+    State state;
+    int cursorX, cursorY;
+    bool wrapPending;            // Cursor sits past the last column; the next character wraps.
+    int scrollTop, scrollBottom;  // Scroll region, rows [scrollTop, scrollBottom).
+    int savedX, savedY;
+    uint32_t savedColor;
+    uint32_t defaultColor;  // Color of text without SGR colors.
+    uint32_t color;         // Color of printed characters.
+    int colorIndex;         // Palette index of color if it came from SGR 30-37, else -1 (for bold).
+    bool bold;
+    bool cursorVisible;
+
+    int params[MAX_PARAMS];
+    int paramCount;
+    bool privateMarker;  // CSI sequence started with '?' (or another private prefix).
+
+    uint32_t utf8Code;     // Code point being decoded.
+    uint32_t utf8Minimum;  // Smallest code point its length may encode (rejects overlong forms).
+    int utf8Remaining;     // Continuation bytes still expected.
+
+    void print(uint32_t code);
+    void control(unsigned char c);
+    void lineFeed();
+    void reverseIndex();
+    void escapeDispatch(unsigned char c);
+    void csiDispatch(unsigned char final);
+    void selectGraphicRendition();
+    void moveCursor(int column, int row);
+    int param(int index, int fallback) const;
+
+    static uint32_t paletteColor(int index);
+};
+
+#endif  // VTTERMINAL_H